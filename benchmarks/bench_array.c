@@ -0,0 +1,343 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "array_macros.h"
+
+/* Items moved per call by the range operations. */
+#define BENCH_BATCH 64
+
+/* Inserts and removes in the middle shift half the array each time. */
+#define BENCH_SHIFT_OPS 256
+
+/* reserve and shrink_to_fit each need a fresh array per sample. */
+#define BENCH_RESIZE_OPS 8
+
+/* One sample per call for the largest count. */
+#define BENCH_MAX_SAMPLES ((size_t)1 << 20)
+
+static const size_t bench_counts[] = {1024, 65536, 1048576};
+
+typedef struct bench_samples
+{
+    const char *operation;
+    size_t element_size;
+    size_t count;
+    size_t sample_count;
+    size_t op_count;
+    double total_ns;
+    double ns_per_op[BENCH_MAX_SAMPLES];
+} BenchSamples;
+
+static BenchSamples bench_samples;
+static volatile uint32_t bench_sink;
+
+/* Cost of the clock reads around a call, taken off every sample. */
+static double bench_clock_ns;
+
+static double bench_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+static void bench_calibrate(void)
+{
+    bench_clock_ns = bench_now_ns();
+
+    for (int i = 0; i < 1000; i++)
+    {
+        const double start = bench_now_ns();
+        const double elapsed = bench_now_ns() - start;
+
+        if (elapsed < bench_clock_ns)
+            bench_clock_ns = elapsed;
+    }
+}
+
+static void bench_begin(
+    const char *operation, size_t element_size, size_t count)
+{
+    bench_samples.operation = operation;
+    bench_samples.element_size = element_size;
+    bench_samples.count = count;
+    bench_samples.sample_count = 0;
+    bench_samples.op_count = 0;
+    bench_samples.total_ns = 0;
+}
+
+static void bench_record(double elapsed_ns, size_t op_count)
+{
+    elapsed_ns = elapsed_ns > bench_clock_ns ? elapsed_ns - bench_clock_ns : 0;
+
+    if (bench_samples.sample_count < BENCH_MAX_SAMPLES)
+        bench_samples.ns_per_op[bench_samples.sample_count++] =
+            elapsed_ns / (double)op_count;
+
+    bench_samples.op_count += op_count;
+    bench_samples.total_ns += elapsed_ns;
+}
+
+static int bench_compare(const void *a, const void *b)
+{
+    const double x = *(const double *)a;
+    const double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+static double bench_percentile(double percentile)
+{
+    const size_t last = bench_samples.sample_count - 1;
+
+    return bench_samples.ns_per_op[(size_t)(percentile * (double)last)];
+}
+
+static void bench_report(void)
+{
+    if (!bench_samples.sample_count)
+        return;
+
+    qsort(
+        bench_samples.ns_per_op,
+        bench_samples.sample_count,
+        sizeof(double),
+        bench_compare);
+
+    printf(
+        "%-14s %4zu %8zu %10.3f %9.1f %9.1f %9.1f %11.1f\n",
+        bench_samples.operation,
+        bench_samples.element_size,
+        bench_samples.count,
+        (double)bench_samples.op_count * 1e3 / bench_samples.total_ns,
+        bench_percentile(0.50),
+        bench_percentile(0.90),
+        bench_percentile(0.99),
+        bench_percentile(1.0));
+}
+
+/*
+ * Generates an element type of the given number of 32-bit words, its
+ * array and a runner that times each operation at one count. Single-item
+ * operations are timed one call at a time so a growth step shows up in
+ * the tail rather than being averaged into a batch.
+ */
+#define DEFINE_BENCH(prefix, name, word_count)                                \
+    typedef struct                                                            \
+    {                                                                         \
+        uint32_t words[word_count];                                           \
+    } name;                                                                   \
+                                                                              \
+    DECLARE_ARRAY_STRUCT(prefix, name)                                        \
+    DECLARE_ARRAY_FUNCTIONS(prefix, name, name)                               \
+    DEFINE_ARRAY_STRUCT(prefix, name, name)                                   \
+    DEFINE_ARRAY_FUNCTIONS(prefix, name, name)                                \
+                                                                              \
+    static name prefix##_item(size_t seed)                                    \
+    {                                                                         \
+        name item;                                                            \
+        memset(&item, 0, sizeof(item));                                       \
+        item.words[0] = (uint32_t)seed;                                       \
+        return item;                                                          \
+    }                                                                         \
+                                                                              \
+    static name##Array *prefix##_create(size_t capacity)                      \
+    {                                                                         \
+        name##Array *array = prefix##_array_create(capacity);                 \
+        if (!array)                                                           \
+            exit(EXIT_FAILURE);                                               \
+                                                                              \
+        return array;                                                         \
+    }                                                                         \
+                                                                              \
+    static name##Array *prefix##_filled(size_t count)                         \
+    {                                                                         \
+        name##Array *array = prefix##_create(count);                          \
+                                                                              \
+        for (size_t i = 0; i < count; i++)                                    \
+            prefix##_array_push(array, prefix##_item(i));                     \
+                                                                              \
+        return array;                                                         \
+    }                                                                         \
+                                                                              \
+    static void prefix##_bench_push(                                          \
+        const char *operation, name##Array *array, size_t count)              \
+    {                                                                         \
+        const name item = prefix##_item(0);                                   \
+                                                                              \
+        bench_begin(operation, sizeof(name), count);                          \
+        for (size_t i = 0; i < count; i++)                                    \
+        {                                                                     \
+            const double start = bench_now_ns();                              \
+            prefix##_array_push(array, item);                                 \
+            bench_record(bench_now_ns() - start, 1);                          \
+        }                                                                     \
+        bench_report();                                                       \
+    }                                                                         \
+                                                                              \
+    static void prefix##_bench(size_t count)                                  \
+    {                                                                         \
+        name##Array *array = prefix##_create(1);                              \
+        name##Array *batch = prefix##_filled(BENCH_BATCH);                    \
+        const name *items = prefix##_array_get_data(batch);                   \
+        name item = prefix##_item(0);                                         \
+        double start;                                                         \
+                                                                              \
+        prefix##_bench_push("push", array, count);                            \
+        prefix##_array_free(array);                                           \
+                                                                              \
+        array = prefix##_create(1);                                           \
+        if (!prefix##_array_reserve(array, count))                            \
+            exit(EXIT_FAILURE);                                               \
+        prefix##_bench_push("push_reserved", array, count);                   \
+        prefix##_array_free(array);                                           \
+                                                                              \
+        array = prefix##_create(1);                                           \
+        bench_begin("push_n", sizeof(name), count);                           \
+        for (size_t i = 0; i < count; i += BENCH_BATCH)                       \
+        {                                                                     \
+            start = bench_now_ns();                                           \
+            prefix##_array_push_n(array, items, BENCH_BATCH);                 \
+            bench_record(bench_now_ns() - start, BENCH_BATCH);                \
+        }                                                                     \
+        bench_report();                                                       \
+        prefix##_array_free(array);                                           \
+                                                                              \
+        array = prefix##_create(1);                                           \
+        bench_begin("append_array", sizeof(name), count);                     \
+        for (size_t i = 0; i < count; i += BENCH_BATCH)                       \
+        {                                                                     \
+            start = bench_now_ns();                                           \
+            prefix##_array_append_array(array, batch);                        \
+            bench_record(bench_now_ns() - start, BENCH_BATCH);                \
+        }                                                                     \
+        bench_report();                                                       \
+                                                                              \
+        bench_begin("get", sizeof(name), count);                              \
+        for (size_t i = 0; i < count; i++)                                    \
+        {                                                                     \
+            start = bench_now_ns();                                           \
+            prefix##_array_get(array, i, &item);                              \
+            bench_record(bench_now_ns() - start, 1);                          \
+            bench_sink += item.words[0];                                      \
+        }                                                                     \
+        bench_report();                                                       \
+                                                                              \
+        bench_begin("set", sizeof(name), count);                              \
+        for (size_t i = 0; i < count; i++)                                    \
+        {                                                                     \
+            start = bench_now_ns();                                           \
+            prefix##_array_set(array, i, items[i % BENCH_BATCH]);             \
+            bench_record(bench_now_ns() - start, 1);                          \
+        }                                                                     \
+        bench_report();                                                       \
+                                                                              \
+        bench_begin("remove_range", sizeof(name), count);                     \
+        while (prefix##_array_get_count(array))                               \
+        {                                                                     \
+            start = bench_now_ns();                                           \
+            prefix##_array_remove_range(                                      \
+                array,                                                        \
+                prefix##_array_get_count(array) - BENCH_BATCH,                \
+                BENCH_BATCH);                                                 \
+            bench_record(bench_now_ns() - start, BENCH_BATCH);                \
+        }                                                                     \
+        bench_report();                                                       \
+        prefix##_array_free(array);                                           \
+                                                                              \
+        array = prefix##_filled(count);                                       \
+        bench_begin("insert_middle", sizeof(name), count);                    \
+        for (size_t i = 0; i < BENCH_SHIFT_OPS; i++)                          \
+        {                                                                     \
+            const size_t middle = prefix##_array_get_count(array) / 2;        \
+            start = bench_now_ns();                                           \
+            prefix##_array_insert(array, middle, item);                       \
+            bench_record(bench_now_ns() - start, 1);                          \
+        }                                                                     \
+        bench_report();                                                       \
+                                                                              \
+        bench_begin("remove_middle", sizeof(name), count);                    \
+        for (size_t i = 0; i < BENCH_SHIFT_OPS; i++)                          \
+        {                                                                     \
+            const size_t middle = prefix##_array_get_count(array) / 2;        \
+            start = bench_now_ns();                                           \
+            prefix##_array_remove(array, middle);                             \
+            bench_record(bench_now_ns() - start, 1);                          \
+        }                                                                     \
+        bench_report();                                                       \
+                                                                              \
+        bench_begin("insert_range", sizeof(name), count);                     \
+        for (size_t i = 0; i < BENCH_SHIFT_OPS; i++)                          \
+        {                                                                     \
+            const size_t middle = prefix##_array_get_count(array) / 2;        \
+            start = bench_now_ns();                                           \
+            prefix##_array_insert_range(array, middle, items, BENCH_BATCH);   \
+            bench_record(bench_now_ns() - start, BENCH_BATCH);                \
+        }                                                                     \
+        bench_report();                                                       \
+        prefix##_array_free(array);                                           \
+                                                                              \
+        bench_begin("reserve", sizeof(name), count);                          \
+        for (size_t i = 0; i < BENCH_RESIZE_OPS; i++)                         \
+        {                                                                     \
+            array = prefix##_create(1);                                       \
+            start = bench_now_ns();                                           \
+            prefix##_array_reserve(array, count);                             \
+            bench_record(bench_now_ns() - start, 1);                          \
+            prefix##_array_free(array);                                       \
+        }                                                                     \
+        bench_report();                                                       \
+                                                                              \
+        bench_begin("shrink_to_fit", sizeof(name), count);                    \
+        for (size_t i = 0; i < BENCH_RESIZE_OPS; i++)                         \
+        {                                                                     \
+            array = prefix##_filled(count);                                   \
+            prefix##_array_remove_range(array, count / 2, count - count / 2); \
+            start = bench_now_ns();                                           \
+            prefix##_array_shrink_to_fit(array);                              \
+            bench_record(bench_now_ns() - start, 1);                          \
+            prefix##_array_free(array);                                       \
+        }                                                                     \
+        bench_report();                                                       \
+        prefix##_array_free(batch);                                           \
+    }
+
+DEFINE_BENCH(item4, Item4, 1)
+DEFINE_BENCH(item8, Item8, 2)
+DEFINE_BENCH(item16, Item16, 4)
+DEFINE_BENCH(item32, Item32, 8)
+DEFINE_BENCH(item64, Item64, 16)
+
+int main(void)
+{
+    bench_calibrate();
+
+    printf(
+        "%-14s %4s %8s %10s %9s %9s %9s %11s\n",
+        "operation",
+        "size",
+        "count",
+        "Mops/s",
+        "p50 ns",
+        "p90 ns",
+        "p99 ns",
+        "max ns");
+
+    for (size_t i = 0; i < sizeof(bench_counts) / sizeof(*bench_counts); i++)
+    {
+        const size_t count = bench_counts[i];
+
+        item4_bench(count);
+        item8_bench(count);
+        item16_bench(count);
+        item32_bench(count);
+        item64_bench(count);
+    }
+
+    return 0;
+}
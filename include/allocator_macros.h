@@ -0,0 +1,384 @@
+/*
+ * array-macros
+ * Copyright (C) 2025  Thomas George Hodgkinson
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARRAY_MACROS_ALLOCATOR_MACROS_H
+#define ARRAY_MACROS_ALLOCATOR_MACROS_H
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h> // for max_align_t, size_t
+#include <stdint.h> // for SIZE_MAX
+#include <stdlib.h>
+#include <string.h>
+
+#include "array_macros.h"
+
+/*
+ * Both allocators hand out memory through an ArrayAllocator, so arrays
+ * created with prefix##_array_create_with_allocator can live in them.
+ * Neither is thread-safe: give each worker its own arena or pool.
+ */
+
+#define ARRAY_ALLOCATOR_ALIGNMENT _Alignof(max_align_t)
+
+#define DECLARE_ARENA_ALLOCATOR(prefix, name)              \
+    typedef struct prefix##_arena name##Arena;             \
+                                                           \
+    name##Arena *prefix##_arena_create(size_t block_size); \
+    void prefix##_arena_free(name##Arena *prefix##_arena); \
+                                                           \
+    const ArrayAllocator *prefix##_arena_get_allocator(    \
+        const name##Arena *prefix##_arena);                \
+    void prefix##_arena_reset(name##Arena *prefix##_arena);
+
+#define DEFINE_ARENA_ALLOCATOR(prefix, name)                                        \
+    typedef struct prefix##_arena_block                                             \
+    {                                                                               \
+        struct prefix##_arena_block *next;                                          \
+        size_t size;                                                                \
+        size_t offset;                                                              \
+        max_align_t data[];                                                         \
+    } name##ArenaBlock;                                                             \
+                                                                                    \
+    struct prefix##_arena                                                           \
+    {                                                                               \
+        ArrayAllocator allocator;                                                   \
+        size_t block_size;                                                          \
+        name##ArenaBlock *head;                                                     \
+        unsigned char *last_allocation;                                             \
+    };                                                                              \
+                                                                                    \
+    static void *prefix##_arena_allocate_impl(void *context, size_t size);          \
+    static void *prefix##_arena_reallocate_impl(                                    \
+        void *context, void *ptr, size_t old_size, size_t new_size);                \
+    static void prefix##_arena_deallocate_impl(void *context, void *ptr);           \
+                                                                                    \
+    name##Arena *prefix##_arena_create(size_t block_size)                           \
+    {                                                                               \
+        if (!block_size)                                                            \
+        {                                                                           \
+            ARRAY_MACROS_REPORT("%s: Block size cannot be 0\n", __func__);          \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        if (block_size > SIZE_MAX - sizeof(name##ArenaBlock))                       \
+        {                                                                           \
+            ARRAY_MACROS_REPORT(                                                    \
+                "%s: Block size (%zu) is too large\n",                              \
+                __func__,                                                           \
+                block_size);                                                        \
+            errno = ENOMEM;                                                         \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        name##Arena *prefix##_arena = malloc(sizeof(*prefix##_arena));              \
+        if (!prefix##_arena)                                                        \
+        {                                                                           \
+            ARRAY_MACROS_REPORT_ERRNO(#prefix "_arena allocation failure");         \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        prefix##_arena->allocator.allocate = prefix##_arena_allocate_impl;          \
+        prefix##_arena->allocator.reallocate = prefix##_arena_reallocate_impl;      \
+        prefix##_arena->allocator.deallocate = prefix##_arena_deallocate_impl;      \
+        prefix##_arena->allocator.context = prefix##_arena;                         \
+        prefix##_arena->block_size = block_size;                                    \
+        prefix##_arena->head = NULL;                                                \
+        prefix##_arena->last_allocation = NULL;                                     \
+                                                                                    \
+        return prefix##_arena;                                                      \
+    }                                                                               \
+                                                                                    \
+    void prefix##_arena_free(name##Arena *prefix##_arena)                           \
+    {                                                                               \
+        name##ArenaBlock *block = prefix##_arena->head;                             \
+                                                                                    \
+        while (block)                                                               \
+        {                                                                           \
+            name##ArenaBlock *next = block->next;                                   \
+            free(block);                                                            \
+            block = next;                                                           \
+        }                                                                           \
+                                                                                    \
+        free(prefix##_arena);                                                       \
+    }                                                                               \
+                                                                                    \
+    const ArrayAllocator *prefix##_arena_get_allocator(                             \
+        const name##Arena *prefix##_arena)                                          \
+    {                                                                               \
+        return &prefix##_arena->allocator;                                          \
+    }                                                                               \
+                                                                                    \
+    void prefix##_arena_reset(name##Arena *prefix##_arena)                          \
+    {                                                                               \
+        name##ArenaBlock *block = prefix##_arena->head;                             \
+                                                                                    \
+        if (!block)                                                                 \
+            return;                                                                 \
+                                                                                    \
+        while (block->next)                                                         \
+        {                                                                           \
+            name##ArenaBlock *next = block->next;                                   \
+            free(block);                                                            \
+            block = next;                                                           \
+        }                                                                           \
+                                                                                    \
+        block->offset = 0;                                                          \
+        prefix##_arena->head = block;                                               \
+        prefix##_arena->last_allocation = NULL;                                     \
+    }                                                                               \
+                                                                                    \
+    static void *prefix##_arena_allocate_impl(void *context, size_t size)           \
+    {                                                                               \
+        name##Arena *prefix##_arena = context;                                      \
+                                                                                    \
+        if (size > SIZE_MAX - sizeof(name##ArenaBlock) - ARRAY_ALLOCATOR_ALIGNMENT) \
+        {                                                                           \
+            errno = ENOMEM;                                                         \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        const size_t aligned_size = (size + ARRAY_ALLOCATOR_ALIGNMENT - 1)          \
+            & ~(ARRAY_ALLOCATOR_ALIGNMENT - 1);                                     \
+        name##ArenaBlock *block = prefix##_arena->head;                             \
+                                                                                    \
+        if (!block || aligned_size > block->size - block->offset)                   \
+        {                                                                           \
+            const size_t block_size = aligned_size > prefix##_arena->block_size     \
+                ? aligned_size                                                      \
+                : prefix##_arena->block_size;                                       \
+                                                                                    \
+            /* Both sizes were bounded above, so the header cannot overflow */      \
+            block = malloc(sizeof(*block) + block_size);                            \
+            if (!block)                                                             \
+                return NULL;                                                        \
+                                                                                    \
+            block->next = prefix##_arena->head;                                     \
+            block->size = block_size;                                               \
+            block->offset = 0;                                                      \
+            prefix##_arena->head = block;                                           \
+        }                                                                           \
+                                                                                    \
+        unsigned char *ptr = (unsigned char *)block->data + block->offset;          \
+        block->offset += aligned_size;                                              \
+        prefix##_arena->last_allocation = ptr;                                      \
+                                                                                    \
+        return ptr;                                                                 \
+    }                                                                               \
+                                                                                    \
+    static void *prefix##_arena_reallocate_impl(                                    \
+        void *context, void *ptr, size_t old_size, size_t new_size)                 \
+    {                                                                               \
+        name##Arena *prefix##_arena = context;                                      \
+        name##ArenaBlock *block = prefix##_arena->head;                             \
+                                                                                    \
+        if (ptr && ptr == prefix##_arena->last_allocation                           \
+            && new_size <= SIZE_MAX - ARRAY_ALLOCATOR_ALIGNMENT)                    \
+        {                                                                           \
+            const size_t start =                                                    \
+                (size_t)((unsigned char *)ptr - (unsigned char *)block->data);      \
+            const size_t aligned_size = (new_size + ARRAY_ALLOCATOR_ALIGNMENT - 1)  \
+                & ~(ARRAY_ALLOCATOR_ALIGNMENT - 1);                                 \
+                                                                                    \
+            if (aligned_size <= block->size - start)                                \
+            {                                                                       \
+                block->offset = start + aligned_size;                               \
+                return ptr;                                                         \
+            }                                                                       \
+        }                                                                           \
+                                                                                    \
+        void *new_ptr = prefix##_arena_allocate_impl(context, new_size);            \
+        if (new_ptr && ptr)                                                         \
+            memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);        \
+                                                                                    \
+        return new_ptr;                                                             \
+    }                                                                               \
+                                                                                    \
+    static void prefix##_arena_deallocate_impl(void *context, void *ptr)            \
+    {                                                                               \
+        name##Arena *prefix##_arena = context;                                      \
+                                                                                    \
+        if (!ptr || ptr != prefix##_arena->last_allocation)                         \
+            return;                                                                 \
+                                                                                    \
+        name##ArenaBlock *block = prefix##_arena->head;                             \
+        block->offset =                                                             \
+            (size_t)((unsigned char *)ptr - (unsigned char *)block->data);          \
+        prefix##_arena->last_allocation = NULL;                                     \
+    }
+
+#define DECLARE_POOL_ALLOCATOR(prefix, name)                                 \
+    typedef struct prefix##_pool name##Pool;                                 \
+                                                                             \
+    name##Pool *prefix##_pool_create(size_t block_size, size_t block_count); \
+    void prefix##_pool_free(name##Pool *prefix##_pool);                      \
+                                                                             \
+    const ArrayAllocator *prefix##_pool_get_allocator(                       \
+        const name##Pool *prefix##_pool);                                    \
+    size_t prefix##_pool_get_block_size(const name##Pool *prefix##_pool);    \
+    void prefix##_pool_reset(name##Pool *prefix##_pool);
+
+#define DEFINE_POOL_ALLOCATOR(prefix, name)                                       \
+    struct prefix##_pool                                                          \
+    {                                                                             \
+        ArrayAllocator allocator;                                                 \
+        size_t block_size;                                                        \
+        size_t block_count;                                                       \
+        void *free_list;                                                          \
+        unsigned char *blocks;                                                    \
+    };                                                                            \
+                                                                                  \
+    static void *prefix##_pool_allocate_impl(void *context, size_t size);         \
+    static void *prefix##_pool_reallocate_impl(                                   \
+        void *context, void *ptr, size_t old_size, size_t new_size);              \
+    static void prefix##_pool_deallocate_impl(void *context, void *ptr);          \
+                                                                                  \
+    name##Pool *prefix##_pool_create(size_t block_size, size_t block_count)       \
+    {                                                                             \
+        if (!block_size || !block_count)                                          \
+        {                                                                         \
+            ARRAY_MACROS_REPORT(                                                  \
+                "%s: Block size and count cannot be 0\n",                         \
+                __func__);                                                        \
+            return NULL;                                                          \
+        }                                                                         \
+                                                                                  \
+        if (block_size > SIZE_MAX - ARRAY_ALLOCATOR_ALIGNMENT)                    \
+        {                                                                         \
+            ARRAY_MACROS_REPORT(                                                  \
+                "%s: Block size (%zu) is too large\n",                            \
+                __func__,                                                         \
+                block_size);                                                      \
+            return NULL;                                                          \
+        }                                                                         \
+                                                                                  \
+        block_size = (block_size + ARRAY_ALLOCATOR_ALIGNMENT - 1)                 \
+            & ~(ARRAY_ALLOCATOR_ALIGNMENT - 1);                                   \
+                                                                                  \
+        if (block_count > SIZE_MAX / block_size)                                  \
+        {                                                                         \
+            ARRAY_MACROS_REPORT(                                                  \
+                "%s: Pool of %zu blocks of %zu bytes would overflow\n",           \
+                __func__,                                                         \
+                block_count,                                                      \
+                block_size);                                                      \
+            return NULL;                                                          \
+        }                                                                         \
+                                                                                  \
+        name##Pool *prefix##_pool = malloc(sizeof(*prefix##_pool));               \
+        if (!prefix##_pool)                                                       \
+        {                                                                         \
+            ARRAY_MACROS_REPORT_ERRNO(#prefix "_pool allocation failure");        \
+            return NULL;                                                          \
+        }                                                                         \
+                                                                                  \
+        prefix##_pool->blocks = malloc(block_count * block_size);                 \
+        if (!prefix##_pool->blocks)                                               \
+        {                                                                         \
+            ARRAY_MACROS_REPORT_ERRNO(#prefix "_pool blocks allocation failure"); \
+            free(prefix##_pool);                                                  \
+            return NULL;                                                          \
+        }                                                                         \
+                                                                                  \
+        prefix##_pool->allocator.allocate = prefix##_pool_allocate_impl;          \
+        prefix##_pool->allocator.reallocate = prefix##_pool_reallocate_impl;      \
+        prefix##_pool->allocator.deallocate = prefix##_pool_deallocate_impl;      \
+        prefix##_pool->allocator.context = prefix##_pool;                         \
+        prefix##_pool->block_size = block_size;                                   \
+        prefix##_pool->block_count = block_count;                                 \
+        prefix##_pool_reset(prefix##_pool);                                       \
+                                                                                  \
+        return prefix##_pool;                                                     \
+    }                                                                             \
+                                                                                  \
+    void prefix##_pool_free(name##Pool *prefix##_pool)                            \
+    {                                                                             \
+        free(prefix##_pool->blocks);                                              \
+        free(prefix##_pool);                                                      \
+    }                                                                             \
+                                                                                  \
+    const ArrayAllocator *prefix##_pool_get_allocator(                            \
+        const name##Pool *prefix##_pool)                                          \
+    {                                                                             \
+        return &prefix##_pool->allocator;                                         \
+    }                                                                             \
+                                                                                  \
+    size_t prefix##_pool_get_block_size(const name##Pool *prefix##_pool)          \
+    {                                                                             \
+        return prefix##_pool->block_size;                                         \
+    }                                                                             \
+                                                                                  \
+    void prefix##_pool_reset(name##Pool *prefix##_pool)                           \
+    {                                                                             \
+        prefix##_pool->free_list = NULL;                                          \
+                                                                                  \
+        for (size_t i = prefix##_pool->block_count; i > 0; i--)                   \
+        {                                                                         \
+            void *block =                                                         \
+                prefix##_pool->blocks + (i - 1) * prefix##_pool->block_size;      \
+            *(void **)block = prefix##_pool->free_list;                           \
+            prefix##_pool->free_list = block;                                     \
+        }                                                                         \
+    }                                                                             \
+                                                                                  \
+    static void *prefix##_pool_allocate_impl(void *context, size_t size)          \
+    {                                                                             \
+        name##Pool *prefix##_pool = context;                                      \
+        void *block = prefix##_pool->free_list;                                   \
+                                                                                  \
+        if (size > prefix##_pool->block_size || !block)                           \
+        {                                                                         \
+            errno = ENOMEM;                                                       \
+            return NULL;                                                          \
+        }                                                                         \
+                                                                                  \
+        prefix##_pool->free_list = *(void **)block;                               \
+                                                                                  \
+        return block;                                                             \
+    }                                                                             \
+                                                                                  \
+    static void *prefix##_pool_reallocate_impl(                                   \
+        void *context, void *ptr, size_t old_size, size_t new_size)               \
+    {                                                                             \
+        name##Pool *prefix##_pool = context;                                      \
+        (void)old_size;                                                           \
+                                                                                  \
+        if (!ptr)                                                                 \
+            return prefix##_pool_allocate_impl(context, new_size);                \
+                                                                                  \
+        if (new_size > prefix##_pool->block_size)                                 \
+        {                                                                         \
+            errno = ENOMEM;                                                       \
+            return NULL;                                                          \
+        }                                                                         \
+                                                                                  \
+        return ptr;                                                               \
+    }                                                                             \
+                                                                                  \
+    static void prefix##_pool_deallocate_impl(void *context, void *ptr)           \
+    {                                                                             \
+        name##Pool *prefix##_pool = context;                                      \
+                                                                                  \
+        if (!ptr)                                                                 \
+            return;                                                               \
+                                                                                  \
+        *(void **)ptr = prefix##_pool->free_list;                                 \
+        prefix##_pool->free_list = ptr;                                           \
+    }
+
+#endif // ARRAY_MACROS_ALLOCATOR_MACROS_H
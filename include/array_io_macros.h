@@ -0,0 +1,260 @@
+/*
+ * array-macros
+ * Copyright (C) 2025  Thomas George Hodgkinson
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARRAY_MACROS_ARRAY_IO_MACROS_H
+#define ARRAY_MACROS_ARRAY_IO_MACROS_H
+
+#include <stdbool.h>
+#include <stddef.h> // for size_t
+#include <stdint.h> // for uint32_t, uint64_t
+#include <stdio.h>
+#include <string.h>
+
+#include "array_macros.h"
+
+/*
+ * Binary save and load. A file starts with an ArrayFileHeader followed,
+ * at data_offset, by the raw elements. save writes the whole element block
+ * with a single fwrite. load reads it in chunks that double in size into
+ * a separate buffer that grows only as data arrives, so a corrupt or
+ * truncated file cannot make it reserve far more than the stream holds.
+ * Any failed load leaves the array's old contents in place; a successful
+ * one copies the data in, or swaps in the buffer if the array is too small.
+ *
+ * Files use the host's byte order and element layout, so they are meant
+ * for reloading on the same platform, not for interchange. A file whose
+ * version or element size does not match is rejected. Mapped array files
+ * share the format, so load can read them too.
+ *
+ * DEFINE_ARRAY_IO uses the array's internal helpers, so expand it after
+ * DEFINE_ARRAY_FUNCTIONS.
+ */
+
+#define ARRAY_FILE_MAGIC "ARRMACRO"
+#define ARRAY_FILE_VERSION 1
+
+/* Largest data_offset load accepts, to bound the padding it skips. */
+#define ARRAY_FILE_MAX_DATA_OFFSET 4096
+
+/* Size of the first chunk load reads; later chunks double. */
+#define ARRAY_FILE_LOAD_CHUNK_BYTES 65536
+
+typedef struct array_file_header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t element_size;
+    uint64_t count;
+    uint64_t data_offset;
+} ArrayFileHeader;
+
+static inline void array_file_header_init_impl(
+    ArrayFileHeader *header,
+    size_t element_size,
+    size_t count,
+    size_t data_offset)
+{
+    memcpy(header->magic, ARRAY_FILE_MAGIC, sizeof(header->magic));
+    header->version = ARRAY_FILE_VERSION;
+    header->element_size = (uint32_t)element_size;
+    header->count = count;
+    header->data_offset = data_offset;
+}
+
+static inline bool array_file_header_check_impl(
+    const ArrayFileHeader *header, size_t element_size)
+{
+    if (memcmp(header->magic, ARRAY_FILE_MAGIC, sizeof(header->magic)))
+    {
+        ARRAY_MACROS_REPORT("%s: Not an array file\n", __func__);
+        return false;
+    }
+
+    if (header->version != ARRAY_FILE_VERSION)
+    {
+        ARRAY_MACROS_REPORT(
+            "%s: Unsupported version (%lu)\n",
+            __func__,
+            (unsigned long)header->version);
+        return false;
+    }
+
+    if (header->element_size != element_size)
+    {
+        ARRAY_MACROS_REPORT(
+            "%s: Element size (%lu) does not match (%zu)\n",
+            __func__,
+            (unsigned long)header->element_size,
+            element_size);
+        return false;
+    }
+
+    if (header->data_offset < sizeof(*header)
+        || header->data_offset > ARRAY_FILE_MAX_DATA_OFFSET)
+    {
+        ARRAY_MACROS_REPORT(
+            "%s: Invalid data offset (%llu)\n",
+            __func__,
+            (unsigned long long)header->data_offset);
+        return false;
+    }
+
+    if (header->count > SIZE_MAX / element_size)
+    {
+        ARRAY_MACROS_REPORT(
+            "%s: Count (%llu) is too large\n",
+            __func__,
+            (unsigned long long)header->count);
+        return false;
+    }
+
+    return true;
+}
+
+#define DECLARE_ARRAY_IO(prefix, name, type)                                   \
+    bool prefix##_array_save(const name##Array *prefix##_array, FILE *stream); \
+    bool prefix##_array_load(name##Array *prefix##_array, FILE *stream);
+
+#define DEFINE_ARRAY_IO(prefix, name, type)                                       \
+    bool prefix##_array_save(const name##Array *prefix##_array, FILE *stream)     \
+    {                                                                             \
+        ArrayFileHeader header;                                                   \
+        array_file_header_init_impl(                                              \
+            &header, sizeof(type), prefix##_array->count, sizeof(header));        \
+                                                                                  \
+        if (fwrite(&header, sizeof(header), 1, stream) != 1                       \
+            || fwrite(                                                            \
+                   prefix##_array->data,                                          \
+                   sizeof(type),                                                  \
+                   prefix##_array->count,                                         \
+                   stream)                                                        \
+                != prefix##_array->count)                                         \
+        {                                                                         \
+            ARRAY_MACROS_REPORT_ERRNO(                                            \
+                #prefix "_array_save: Error with fwrite");                        \
+            return false;                                                         \
+        }                                                                         \
+                                                                                  \
+        return true;                                                              \
+    }                                                                             \
+                                                                                  \
+    bool prefix##_array_load(name##Array *prefix##_array, FILE *stream)           \
+    {                                                                             \
+        ArrayFileHeader header;                                                   \
+                                                                                  \
+        if (fread(&header, sizeof(header), 1, stream) != 1)                       \
+        {                                                                         \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_IO);            \
+            ARRAY_MACROS_REPORT_ERRNO(                                            \
+                #prefix "_array_load: Error reading header");                     \
+            return false;                                                         \
+        }                                                                         \
+                                                                                  \
+        if (!array_file_header_check_impl(&header, sizeof(type)))                 \
+        {                                                                         \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_IO);            \
+            return false;                                                         \
+        }                                                                         \
+                                                                                  \
+        /* Skip padding without seeking, so pipes work too. */                    \
+        for (size_t skip = header.data_offset - sizeof(header); skip; skip--)     \
+        {                                                                         \
+            if (fgetc(stream) == EOF)                                             \
+            {                                                                     \
+                ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_IO);        \
+                ARRAY_MACROS_REPORT(                                              \
+                    "%s: File ends before its data\n",                            \
+                    __func__);                                                    \
+                return false;                                                     \
+            }                                                                     \
+        }                                                                         \
+                                                                                  \
+        const ArrayAllocator *allocator = prefix##_array->allocator;              \
+        const size_t count = (size_t)header.count;                                \
+        type *buffer = NULL;                                                      \
+        size_t loaded = 0;                                                        \
+        size_t chunk = ARRAY_FILE_LOAD_CHUNK_BYTES / sizeof(type);                \
+        if (!chunk)                                                               \
+            chunk = 1;                                                            \
+                                                                                  \
+        /* Load into a separate buffer, so failure keeps the old contents */      \
+        while (loaded < count)                                                    \
+        {                                                                         \
+            if (chunk > count - loaded)                                           \
+                chunk = count - loaded;                                           \
+                                                                                  \
+            type *grown = buffer                                                  \
+                ? array_allocator_reallocate_impl(                                \
+                      allocator,                                                  \
+                      buffer,                                                     \
+                      loaded * sizeof(type),                                      \
+                      (loaded + chunk) * sizeof(type))                            \
+                : array_allocator_allocate_impl(                                  \
+                      allocator, chunk * sizeof(type));                           \
+            if (!grown)                                                           \
+            {                                                                     \
+                array_allocator_deallocate_impl(allocator, buffer);               \
+                ARRAY_SET_ERROR_IMPL(                                             \
+                    prefix##_array, ARRAY_ERROR_TYPE_ALLOCATION);                 \
+                ARRAY_MACROS_REPORT_ERRNO(                                        \
+                    #prefix "_array_load: Error allocating data");                \
+                return false;                                                     \
+            }                                                                     \
+            buffer = grown;                                                       \
+                                                                                  \
+            if (fread(&buffer[loaded], sizeof(type), chunk, stream) != chunk)     \
+            {                                                                     \
+                array_allocator_deallocate_impl(allocator, buffer);               \
+                ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_IO);        \
+                ARRAY_MACROS_REPORT(                                              \
+                    "%s: File ends before its %zu items\n",                       \
+                    __func__,                                                     \
+                    count);                                                       \
+                return false;                                                     \
+            }                                                                     \
+                                                                                  \
+            loaded += chunk;                                                      \
+            chunk = loaded;                                                       \
+        }                                                                         \
+                                                                                  \
+        /* Copy into the existing block when it is big enough, else swap */       \
+        if (count <= prefix##_array->capacity)                                    \
+        {                                                                         \
+            if (count)                                                            \
+                memcpy(prefix##_array->data, buffer, count * sizeof(type));       \
+            ARRAY_STATS_ADD_IMPL(                                                 \
+                prefix##_array, bytes_moved, count * sizeof(type));               \
+            array_allocator_deallocate_impl(allocator, buffer);                   \
+        }                                                                         \
+        else                                                                      \
+        {                                                                         \
+            if (!prefix##_array_is_inline_impl(prefix##_array))                   \
+                array_allocator_deallocate_impl(                                  \
+                    allocator, prefix##_array->data);                             \
+            prefix##_array->data = buffer;                                        \
+            prefix##_array->capacity = count;                                     \
+            ARRAY_STATS_ADD_IMPL(prefix##_array, reallocs, 1);                    \
+            ARRAY_STATS_PEAK_IMPL(prefix##_array);                                \
+        }                                                                         \
+                                                                                  \
+        prefix##_array->count = count;                                            \
+                                                                                  \
+        return true;                                                              \
+    }
+
+#endif // ARRAY_MACROS_ARRAY_IO_MACROS_H
@@ -21,88 +21,326 @@
 
 #include <stdbool.h>
 #include <stddef.h> // for size_t
-#include <stdint.h> // for SIZE_MAX
+#include <stdint.h> // for SIZE_MAX, uintptr_t
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/*
+ * Define ARRAY_MACROS_NO_DIAGNOSTICS to compile out the stderr messages.
+ * Failures are still reported through the return value and recorded in
+ * the array's last error, so hot paths carry no stdio calls.
+ */
+#ifdef ARRAY_MACROS_NO_DIAGNOSTICS
+#define ARRAY_MACROS_REPORT(...) ((void)0)
+#define ARRAY_MACROS_REPORT_ERRNO(message) ((void)0)
+#else
+#define ARRAY_MACROS_REPORT(...) fprintf(stderr, __VA_ARGS__)
+#define ARRAY_MACROS_REPORT_ERRNO(message) perror(message)
+#endif
+
+/*
+ * Growth policies take the current capacity and return the next one. Any
+ * function-like macro of one argument can be passed to
+ * DEFINE_ARRAY_FUNCTIONS_EX, e.g. `#define GROW_BY_64(c) ((c) + 64)`.
+ */
+#define ARRAY_GROWTH_DOUBLE(capacity) ((capacity) * 2)
+#define ARRAY_GROWTH_ONE_AND_HALF(capacity) ((capacity) + (capacity) / 2 + 1)
+
+typedef enum array_layout_type
+{
+    ARRAY_LAYOUT_TYPE_NONE,
+    ARRAY_LAYOUT_TYPE_SPLIT,
+    ARRAY_LAYOUT_TYPE_SINGLE
+} ArrayLayoutType;
+
+typedef enum array_error_type
+{
+    ARRAY_ERROR_TYPE_NONE,
+    ARRAY_ERROR_TYPE_EMPTY,
+    ARRAY_ERROR_TYPE_OUT_OF_BOUNDS,
+    ARRAY_ERROR_TYPE_OVERFLOW,
+    ARRAY_ERROR_TYPE_ALLOCATION,
+    ARRAY_ERROR_TYPE_IO,
+    ARRAY_ERROR_TYPE_SIZE_MISMATCH
+} ArrayErrorType;
+
+/*
+ * Routes an array's memory through caller-supplied functions. The array
+ * keeps a pointer to the allocator, so it must outlive the array. A NULL
+ * allocator means malloc, realloc and free.
+ */
+typedef struct array_allocator
+{
+    void *(*allocate)(void *context, size_t size);
+    void *(*reallocate)(
+        void *context, void *ptr, size_t old_size, size_t new_size);
+    void (*deallocate)(void *context, void *ptr);
+    void *context;
+} ArrayAllocator;
+
+static inline void *array_allocator_allocate_impl(
+    const ArrayAllocator *allocator, size_t size)
+{
+    if (!allocator)
+        return malloc(size);
+
+    return allocator->allocate(allocator->context, size);
+}
+
+static inline void *array_allocator_reallocate_impl(
+    const ArrayAllocator *allocator,
+    void *ptr,
+    size_t old_size,
+    size_t new_size)
+{
+    if (!allocator)
+        return realloc(ptr, new_size);
+
+    return allocator->reallocate(allocator->context, ptr, old_size, new_size);
+}
+
+static inline void array_allocator_deallocate_impl(
+    const ArrayAllocator *allocator, void *ptr)
+{
+    if (!allocator)
+    {
+        free(ptr);
+        return;
+    }
+
+    allocator->deallocate(allocator->context, ptr);
+}
+
+/*
+ * Growth and failure counters, kept per container when ARRAY_MACROS_STATS
+ * is defined. bytes_moved counts the bytes the library copies itself:
+ * shifts by insert and remove (every column, for SoA arrays), and moves
+ * into or out of inline storage, a new deque buffer or a new SoA block.
+ * Copies made inside realloc are not seen.
+ * Without ARRAY_MACROS_STATS the counters are compiled out and get_stats
+ * returns zeros.
+ */
+typedef struct array_stats
+{
+    size_t reallocs;
+    size_t bytes_moved;
+    size_t peak_capacity;
+    size_t failed_ops;
+} ArrayStats;
+
+#ifdef ARRAY_MACROS_STATS
+#define ARRAY_STATS_FIELD_IMPL ArrayStats stats;
+#define ARRAY_STATS_INIT_IMPL(array) \
+    ((array)->stats = (ArrayStats){.peak_capacity = (array)->capacity})
+#define ARRAY_STATS_ADD_IMPL(array, field, amount) \
+    ((array)->stats.field += (amount))
+#define ARRAY_STATS_PEAK_IMPL(array)                                \
+    ((array)->stats.peak_capacity < (array)->capacity               \
+         ? (void)((array)->stats.peak_capacity = (array)->capacity) \
+         : (void)0)
+#define ARRAY_STATS_GET_IMPL(array) ((array)->stats)
+#else
+#define ARRAY_STATS_FIELD_IMPL
+#define ARRAY_STATS_INIT_IMPL(array) ((void)0)
+#define ARRAY_STATS_ADD_IMPL(array, field, amount) ((void)0)
+#define ARRAY_STATS_PEAK_IMPL(array) ((void)0)
+#define ARRAY_STATS_GET_IMPL(array) ((void)(array), (ArrayStats){0})
+#endif
+
+/* Records an error on an array and counts the failed operation. */
+#define ARRAY_SET_ERROR_IMPL(array, error) \
+    ((array)->last_error = (error), ARRAY_STATS_ADD_IMPL(array, failed_ops, 1))
+
 #define DECLARE_ARRAY_STRUCT(prefix, name) \
     typedef struct prefix##_array name##Array;
 
 #define DECLARE_ARRAY_FUNCTIONS(prefix, name, type)                                     \
+    typedef struct prefix##_array_span                                                  \
+    {                                                                                   \
+        type *data;                                                                     \
+        size_t count;                                                                   \
+    } name##ArraySpan;                                                                  \
+                                                                                        \
     name##Array *prefix##_array_create(size_t initial_capacity);                        \
+    name##Array *prefix##_array_create_with_allocator(                                  \
+        size_t initial_capacity, const ArrayAllocator *allocator);                      \
     void prefix##_array_free(name##Array *prefix##_array);                              \
                                                                                         \
     size_t prefix##_array_get_count(const name##Array *prefix##_array);                 \
     size_t prefix##_array_get_capacity(const name##Array *prefix##_array);              \
+    const type *prefix##_array_get_data(const name##Array *prefix##_array);             \
+    type *prefix##_array_get_data_mut(name##Array *prefix##_array);                     \
+    name##ArraySpan prefix##_array_get_span(name##Array *prefix##_array);               \
+    ArrayErrorType prefix##_array_get_last_error(                                       \
+        const name##Array *prefix##_array);                                             \
+    void prefix##_array_get_stats(                                                      \
+        const name##Array *prefix##_array, ArrayStats *out_stats);                      \
                                                                                         \
     bool prefix##_array_push(name##Array *prefix##_array, type item);                   \
     bool prefix##_array_insert(name##Array *prefix##_array, size_t index, type item);   \
+    bool prefix##_array_push_n(                                                         \
+        name##Array *prefix##_array, const type *items, size_t item_count);             \
+    bool prefix##_array_insert_range(                                                   \
+        name##Array *prefix##_array,                                                    \
+        size_t index,                                                                   \
+        const type *items,                                                              \
+        size_t item_count);                                                             \
+    bool prefix##_array_append_array(                                                   \
+        name##Array *prefix##_array, const name##Array *other);                         \
     bool prefix##_array_set(name##Array *prefix##_array, size_t index, type item);      \
     bool prefix##_array_remove(name##Array *prefix##_array, size_t index);              \
+    bool prefix##_array_remove_range(                                                   \
+        name##Array *prefix##_array, size_t index, size_t item_count);                  \
     bool prefix##_array_get(name##Array *prefix##_array, size_t index, type *out_item); \
     bool prefix##_array_is_empty(const name##Array *prefix##_array);                    \
     bool prefix##_array_is_full(const name##Array *prefix##_array);                     \
-    void prefix##_array_clear(name##Array *prefix##_array);
+    void prefix##_array_clear(name##Array *prefix##_array);                             \
+    bool prefix##_array_reserve(name##Array *prefix##_array, size_t capacity);          \
+    bool prefix##_array_shrink_to_fit(name##Array *prefix##_array);
 
+/*
+ * Both layouts share this struct. Elements are always read through data,
+ * which points at inline_data while a single-allocation array has not
+ * spilled; split arrays leave inline_capacity at 0 and inline_data empty.
+ */
 #define DEFINE_ARRAY_STRUCT(prefix, name, type) \
     typedef struct prefix##_array               \
     {                                           \
         type *data;                             \
         size_t count;                           \
         size_t capacity;                        \
+        ArrayErrorType last_error;              \
+        const ArrayAllocator *allocator;        \
+        size_t inline_capacity;                 \
+        ARRAY_STATS_FIELD_IMPL                  \
+        type inline_data[];                     \
     } name##Array;
 
-#define DEFINE_ARRAY_FUNCTIONS(prefix, name, type)                                     \
-    static inline bool prefix##_array_grow_impl(name##Array *prefix##_array);          \
-                                                                                       \
-    name##Array *prefix##_array_create(size_t initial_capacity)                        \
+/*
+ * Bounds-unchecked accessors over a span from get_span, for hot loops.
+ * They only need the span type, so they can be expanded in a public header
+ * after DECLARE_ARRAY_FUNCTIONS while the array itself stays opaque.
+ */
+#define DEFINE_ARRAY_UNCHECKED_FUNCTIONS(prefix, name, type) \
+    static inline type prefix##_array_span_get_unchecked(    \
+        name##ArraySpan span, size_t index)                  \
+    {                                                        \
+        return span.data[index];                             \
+    }                                                        \
+                                                             \
+    static inline void prefix##_array_span_set_unchecked(    \
+        name##ArraySpan span, size_t index, type item)       \
+    {                                                        \
+        span.data[index] = item;                             \
+    }
+
+#define DEFINE_ARRAY_FUNCTIONS(prefix, name, type) \
+    DEFINE_ARRAY_FUNCTIONS_EX(                     \
+        prefix, name, type, ARRAY_LAYOUT_TYPE_SPLIT, ARRAY_GROWTH_DOUBLE)
+
+#define DEFINE_ARRAY_FUNCTIONS_SINGLE_ALLOC(prefix, name, type) \
+    DEFINE_ARRAY_FUNCTIONS_EX(                                  \
+        prefix, name, type, ARRAY_LAYOUT_TYPE_SINGLE, ARRAY_GROWTH_DOUBLE)
+
+#define DEFINE_ARRAY_FUNCTIONS_EX(prefix, name, type, layout, growth)                  \
+    static inline bool prefix##_array_grow_impl(                                       \
+        name##Array *prefix##_array, size_t additional);                               \
+    static inline bool prefix##_array_resize_impl(                                     \
+        name##Array *prefix##_array, size_t new_capacity);                             \
+                                                                                       \
+    name##Array *prefix##_array_create_with_allocator(                                 \
+        size_t initial_capacity, const ArrayAllocator *allocator)                      \
     {                                                                                  \
         if (!initial_capacity)                                                         \
         {                                                                              \
-            fprintf(                                                                   \
-                stderr,                                                                \
+            ARRAY_MACROS_REPORT(                                                       \
                 "%s: Initial capacity cannot be 0\n",                                  \
                 __func__);                                                             \
             return NULL;                                                               \
         }                                                                              \
                                                                                        \
-        name##Array *prefix##_array = malloc(sizeof(*prefix##_array));                 \
-        if (!prefix##_array)                                                           \
+        const size_t header_size = sizeof(name##Array);                                \
+        const size_t max_capacity = layout == ARRAY_LAYOUT_TYPE_SINGLE                 \
+            ? (SIZE_MAX - header_size) / sizeof(type)                                  \
+            : SIZE_MAX / sizeof(type);                                                 \
+                                                                                       \
+        if (initial_capacity > max_capacity)                                           \
         {                                                                              \
-            perror(#prefix "_array allocation failure");                               \
+            ARRAY_MACROS_REPORT(                                                       \
+                "%s: Initial capacity cannot be greater than %zu\n",                   \
+                __func__,                                                              \
+                max_capacity);                                                         \
             return NULL;                                                               \
         }                                                                              \
                                                                                        \
-        if (initial_capacity > SIZE_MAX / sizeof(*prefix##_array->data))               \
+        if (layout == ARRAY_LAYOUT_TYPE_SINGLE)                                        \
         {                                                                              \
-            fprintf(                                                                   \
-                stderr,                                                                \
-                "%s: Initial capacity cannot be greater than %zu\n",                   \
-                __func__,                                                              \
-                SIZE_MAX / sizeof(*prefix##_array->data));                             \
-            free(prefix##_array);                                                      \
+            name##Array *prefix##_array = array_allocator_allocate_impl(               \
+                allocator, header_size + initial_capacity * sizeof(type));             \
+            if (!prefix##_array)                                                       \
+            {                                                                          \
+                ARRAY_MACROS_REPORT_ERRNO(#prefix "_array allocation failure");        \
+                return NULL;                                                           \
+            }                                                                          \
+                                                                                       \
+            prefix##_array->data = prefix##_array->inline_data;                        \
+            prefix##_array->count = 0;                                                 \
+            prefix##_array->capacity = initial_capacity;                               \
+            prefix##_array->inline_capacity = initial_capacity;                        \
+            prefix##_array->last_error = ARRAY_ERROR_TYPE_NONE;                        \
+            prefix##_array->allocator = allocator;                                     \
+            ARRAY_STATS_INIT_IMPL(prefix##_array);                                     \
+                                                                                       \
+            return prefix##_array;                                                     \
+        }                                                                              \
+                                                                                       \
+        name##Array *prefix##_array =                                                  \
+            array_allocator_allocate_impl(allocator, header_size);                     \
+        if (!prefix##_array)                                                           \
+        {                                                                              \
+            ARRAY_MACROS_REPORT_ERRNO(#prefix "_array allocation failure");            \
             return NULL;                                                               \
         }                                                                              \
                                                                                        \
         prefix##_array->count = 0;                                                     \
         prefix##_array->capacity = initial_capacity;                                   \
-        prefix##_array->data = malloc(                                                 \
+        prefix##_array->inline_capacity = 0;                                           \
+        prefix##_array->last_error = ARRAY_ERROR_TYPE_NONE;                            \
+        prefix##_array->allocator = allocator;                                         \
+        ARRAY_STATS_INIT_IMPL(prefix##_array);                                         \
+        prefix##_array->data = array_allocator_allocate_impl(                          \
+            allocator,                                                                 \
             prefix##_array->capacity * sizeof(*prefix##_array->data));                 \
         if (!prefix##_array->data)                                                     \
         {                                                                              \
-            perror(#prefix "_array data allocation failure");                          \
-            free(prefix##_array);                                                      \
+            ARRAY_MACROS_REPORT_ERRNO(#prefix "_array data allocation failure");       \
+            array_allocator_deallocate_impl(allocator, prefix##_array);                \
             return NULL;                                                               \
         }                                                                              \
                                                                                        \
         return prefix##_array;                                                         \
     }                                                                                  \
                                                                                        \
+    name##Array *prefix##_array_create(size_t initial_capacity)                        \
+    {                                                                                  \
+        return prefix##_array_create_with_allocator(initial_capacity, NULL);           \
+    }                                                                                  \
+                                                                                       \
+    static inline bool prefix##_array_is_inline_impl(                                  \
+        const name##Array *prefix##_array)                                             \
+    {                                                                                  \
+        return layout == ARRAY_LAYOUT_TYPE_SINGLE                                      \
+            && prefix##_array->data == prefix##_array->inline_data;                    \
+    }                                                                                  \
+                                                                                       \
     void prefix##_array_free(name##Array *prefix##_array)                              \
     {                                                                                  \
-        free(prefix##_array->data);                                                    \
-        free(prefix##_array);                                                          \
+        const ArrayAllocator *allocator = prefix##_array->allocator;                   \
+                                                                                       \
+        if (!prefix##_array_is_inline_impl(prefix##_array))                            \
+            array_allocator_deallocate_impl(allocator, prefix##_array->data);          \
+        array_allocator_deallocate_impl(allocator, prefix##_array);                    \
     }                                                                                  \
                                                                                        \
     size_t prefix##_array_get_count(const name##Array *prefix##_array)                 \
@@ -115,9 +353,37 @@
         return prefix##_array->capacity;                                               \
     }                                                                                  \
                                                                                        \
+    const type *prefix##_array_get_data(const name##Array *prefix##_array)             \
+    {                                                                                  \
+        return prefix##_array->data;                                                   \
+    }                                                                                  \
+                                                                                       \
+    type *prefix##_array_get_data_mut(name##Array *prefix##_array)                     \
+    {                                                                                  \
+        return prefix##_array->data;                                                   \
+    }                                                                                  \
+                                                                                       \
+    name##ArraySpan prefix##_array_get_span(name##Array *prefix##_array)               \
+    {                                                                                  \
+        name##ArraySpan span = {prefix##_array->data, prefix##_array->count};          \
+        return span;                                                                   \
+    }                                                                                  \
+                                                                                       \
+    ArrayErrorType prefix##_array_get_last_error(                                      \
+        const name##Array *prefix##_array)                                             \
+    {                                                                                  \
+        return prefix##_array->last_error;                                             \
+    }                                                                                  \
+                                                                                       \
+    void prefix##_array_get_stats(                                                     \
+        const name##Array *prefix##_array, ArrayStats *out_stats)                      \
+    {                                                                                  \
+        *out_stats = ARRAY_STATS_GET_IMPL(prefix##_array);                             \
+    }                                                                                  \
+                                                                                       \
     bool prefix##_array_push(name##Array *prefix##_array, type item)                   \
     {                                                                                  \
-        if (!prefix##_array_grow_impl(prefix##_array))                                 \
+        if (!prefix##_array_grow_impl(prefix##_array, 1))                              \
             return false;                                                              \
         prefix##_array->data[prefix##_array->count++] = item;                          \
         return true;                                                                   \
@@ -125,13 +391,13 @@
                                                                                        \
     bool prefix##_array_insert(name##Array *prefix##_array, size_t index, type item)   \
     {                                                                                  \
-        if (!prefix##_array_grow_impl(prefix##_array))                                 \
+        if (!prefix##_array_grow_impl(prefix##_array, 1))                              \
             return false;                                                              \
                                                                                        \
         if (index > prefix##_array->count)                                             \
         {                                                                              \
-            fprintf(                                                                   \
-                stderr,                                                                \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);      \
+            ARRAY_MACROS_REPORT(                                                       \
                 "%s: Index (%zu) out of bounds (%zu)\n",                               \
                 __func__,                                                              \
                 index,                                                                 \
@@ -148,6 +414,10 @@
         memmove(                                                                       \
             &prefix##_array->data[index + 1],                                          \
             &prefix##_array->data[index],                                              \
+            (prefix##_array->count - index) * sizeof(*prefix##_array->data));          \
+        ARRAY_STATS_ADD_IMPL(                                                          \
+            prefix##_array,                                                            \
+            bytes_moved,                                                               \
             (prefix##_array->count - index) * sizeof(*prefix##_array->data));          \
                                                                                        \
         prefix##_array->data[index] = item;                                            \
@@ -156,18 +426,144 @@
         return true;                                                                   \
     }                                                                                  \
                                                                                        \
+    /* Whether items points into the array's own buffer. */                            \
+    static inline bool prefix##_array_owns_impl(                                       \
+        const name##Array *prefix##_array, const type *items)                          \
+    {                                                                                  \
+        const uintptr_t address = (uintptr_t)items;                                    \
+        const uintptr_t begin = (uintptr_t)prefix##_array->data;                       \
+                                                                                       \
+        return address >= begin                                                        \
+            && address - begin                                                         \
+                < prefix##_array->count * sizeof(*prefix##_array->data);               \
+    }                                                                                  \
+                                                                                       \
+    bool prefix##_array_push_n(                                                        \
+        name##Array *prefix##_array, const type *items, size_t item_count)             \
+    {                                                                                  \
+        if (!item_count)                                                               \
+            return true;                                                               \
+                                                                                       \
+        /* Growing may move the buffer, so aliased items are kept as an offset */      \
+        const bool aliased = prefix##_array_owns_impl(prefix##_array, items);          \
+        const size_t offset = aliased ? (size_t)(items - prefix##_array->data) : 0;    \
+                                                                                       \
+        if (!prefix##_array_grow_impl(prefix##_array, item_count))                     \
+            return false;                                                              \
+                                                                                       \
+        if (aliased)                                                                   \
+            items = &prefix##_array->data[offset];                                     \
+                                                                                       \
+        memcpy(                                                                        \
+            &prefix##_array->data[prefix##_array->count],                              \
+            items,                                                                     \
+            item_count * sizeof(*prefix##_array->data));                               \
+        prefix##_array->count += item_count;                                           \
+                                                                                       \
+        return true;                                                                   \
+    }                                                                                  \
+                                                                                       \
+    bool prefix##_array_insert_range(                                                  \
+        name##Array *prefix##_array,                                                   \
+        size_t index,                                                                  \
+        const type *items,                                                             \
+        size_t item_count)                                                             \
+    {                                                                                  \
+        if (index > prefix##_array->count)                                             \
+        {                                                                              \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);      \
+            ARRAY_MACROS_REPORT(                                                       \
+                "%s: Index (%zu) out of bounds (%zu)\n",                               \
+                __func__,                                                              \
+                index,                                                                 \
+                prefix##_array->count);                                                \
+            return false;                                                              \
+        }                                                                              \
+                                                                                       \
+        if (!item_count)                                                               \
+            return true;                                                               \
+                                                                                       \
+        const bool aliased = prefix##_array_owns_impl(prefix##_array, items);          \
+        const size_t offset = aliased ? (size_t)(items - prefix##_array->data) : 0;    \
+                                                                                       \
+        if (!prefix##_array_grow_impl(prefix##_array, item_count))                     \
+            return false;                                                              \
+                                                                                       \
+        memmove(                                                                       \
+            &prefix##_array->data[index + item_count],                                 \
+            &prefix##_array->data[index],                                              \
+            (prefix##_array->count - index) * sizeof(*prefix##_array->data));          \
+        ARRAY_STATS_ADD_IMPL(                                                          \
+            prefix##_array,                                                            \
+            bytes_moved,                                                               \
+            (prefix##_array->count - index) * sizeof(*prefix##_array->data));          \
+                                                                                       \
+        if (!aliased)                                                                  \
+        {                                                                              \
+            memcpy(                                                                    \
+                &prefix##_array->data[index],                                          \
+                items,                                                                 \
+                item_count * sizeof(*prefix##_array->data));                           \
+        }                                                                              \
+        else                                                                           \
+        {                                                                              \
+            /*                                                                         \
+             * Aliased items before index stayed put; the rest moved up with           \
+             * the shift. Neither part overlaps the gap being filled.                  \
+             */                                                                        \
+            size_t before = 0;                                                         \
+            if (offset < index)                                                        \
+                before = index - offset < item_count ? index - offset : item_count;    \
+                                                                                       \
+            memcpy(                                                                    \
+                &prefix##_array->data[index],                                          \
+                &prefix##_array->data[offset],                                         \
+                before * sizeof(*prefix##_array->data));                               \
+            memcpy(                                                                    \
+                &prefix##_array->data[index + before],                                 \
+                &prefix##_array->data[offset + before + item_count],                   \
+                (item_count - before) * sizeof(*prefix##_array->data));                \
+        }                                                                              \
+                                                                                       \
+        prefix##_array->count += item_count;                                           \
+                                                                                       \
+        return true;                                                                   \
+    }                                                                                  \
+                                                                                       \
+    bool prefix##_array_append_array(                                                  \
+        name##Array *prefix##_array, const name##Array *other)                         \
+    {                                                                                  \
+        /* Read the count before growing, as other may alias the array */              \
+        const size_t item_count = other->count;                                        \
+                                                                                       \
+        if (!item_count)                                                               \
+            return true;                                                               \
+                                                                                       \
+        if (!prefix##_array_grow_impl(prefix##_array, item_count))                     \
+            return false;                                                              \
+                                                                                       \
+        memcpy(                                                                        \
+            &prefix##_array->data[prefix##_array->count],                              \
+            other->data,                                                               \
+            item_count * sizeof(*prefix##_array->data));                               \
+        prefix##_array->count += item_count;                                           \
+                                                                                       \
+        return true;                                                                   \
+    }                                                                                  \
+                                                                                       \
     bool prefix##_array_set(name##Array *prefix##_array, size_t index, type item)      \
     {                                                                                  \
         if (prefix##_array->count == 0)                                                \
         {                                                                              \
-            fprintf(stderr, "%s: Array is empty (count 0)\n", __func__);               \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_EMPTY);              \
+            ARRAY_MACROS_REPORT("%s: Array is empty (count 0)\n", __func__);           \
             return false;                                                              \
         }                                                                              \
                                                                                        \
         if (index >= prefix##_array->count)                                            \
         {                                                                              \
-            fprintf(                                                                   \
-                stderr,                                                                \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);      \
+            ARRAY_MACROS_REPORT(                                                       \
                 "%s: Index (%zu) out of bounds (%zu)\n",                               \
                 __func__,                                                              \
                 index,                                                                 \
@@ -184,14 +580,15 @@
     {                                                                                  \
         if (prefix##_array->count == 0)                                                \
         {                                                                              \
-            fprintf(stderr, "%s: Array is empty (count 0)\n", __func__);               \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_EMPTY);              \
+            ARRAY_MACROS_REPORT("%s: Array is empty (count 0)\n", __func__);           \
             return false;                                                              \
         }                                                                              \
                                                                                        \
         if (index >= prefix##_array->count)                                            \
         {                                                                              \
-            fprintf(                                                                   \
-                stderr,                                                                \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);      \
+            ARRAY_MACROS_REPORT(                                                       \
                 "%s: index (%zu) out of bounds (%zu)\n",                               \
                 __func__,                                                              \
                 index,                                                                 \
@@ -208,25 +605,61 @@
         memmove(                                                                       \
             &prefix##_array->data[index],                                              \
             &prefix##_array->data[index + 1],                                          \
-            (prefix##_array->count - index + 1) * sizeof(*prefix##_array->data));      \
+            (prefix##_array->count - index - 1) * sizeof(*prefix##_array->data));      \
+        ARRAY_STATS_ADD_IMPL(                                                          \
+            prefix##_array,                                                            \
+            bytes_moved,                                                               \
+            (prefix##_array->count - index - 1) * sizeof(*prefix##_array->data));      \
                                                                                        \
         prefix##_array->count--;                                                       \
                                                                                        \
         return true;                                                                   \
     }                                                                                  \
                                                                                        \
+    bool prefix##_array_remove_range(                                                  \
+        name##Array *prefix##_array, size_t index, size_t item_count)                  \
+    {                                                                                  \
+        if (index > prefix##_array->count                                              \
+            || item_count > prefix##_array->count - index)                             \
+        {                                                                              \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);      \
+            ARRAY_MACROS_REPORT(                                                       \
+                "%s: Range (%zu, %zu) out of bounds (%zu)\n",                          \
+                __func__,                                                              \
+                index,                                                                 \
+                item_count,                                                            \
+                prefix##_array->count);                                                \
+            return false;                                                              \
+        }                                                                              \
+                                                                                       \
+        memmove(                                                                       \
+            &prefix##_array->data[index],                                              \
+            &prefix##_array->data[index + item_count],                                 \
+            (prefix##_array->count - index - item_count)                               \
+                * sizeof(*prefix##_array->data));                                      \
+        ARRAY_STATS_ADD_IMPL(                                                          \
+            prefix##_array,                                                            \
+            bytes_moved,                                                               \
+            (prefix##_array->count - index - item_count)                               \
+                * sizeof(*prefix##_array->data));                                      \
+        prefix##_array->count -= item_count;                                           \
+                                                                                       \
+        return true;                                                                   \
+    }                                                                                  \
+                                                                                       \
     bool prefix##_array_get(name##Array *prefix##_array, size_t index, type *out_item) \
     {                                                                                  \
         if (prefix##_array->count == 0)                                                \
         {                                                                              \
-            fprintf(stderr, "%s: Array is empty (count 0)\n", __func__);               \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_EMPTY);              \
+            ARRAY_MACROS_REPORT("%s: Array is empty (count 0)\n", __func__);           \
             return false;                                                              \
         }                                                                              \
                                                                                        \
         if (index >= prefix##_array->count)                                            \
         {                                                                              \
-            fprintf(                                                                   \
-                stderr,                                                                \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);      \
+            ARRAY_MACROS_REPORT(                                                       \
                 "%s: Index (%zu) out of bounds (%zu)\n",                               \
                 __func__,                                                              \
                 index,                                                                 \
@@ -254,29 +687,92 @@
         prefix##_array->count = 0;                                                     \
     }                                                                                  \
                                                                                        \
-    static inline bool prefix##_array_grow_impl(name##Array *prefix##_array)           \
+    bool prefix##_array_reserve(name##Array *prefix##_array, size_t capacity)          \
+    {                                                                                  \
+        if (capacity <= prefix##_array->capacity)                                      \
+            return true;                                                               \
+                                                                                       \
+        return prefix##_array_resize_impl(prefix##_array, capacity);                   \
+    }                                                                                  \
+                                                                                       \
+    bool prefix##_array_shrink_to_fit(name##Array *prefix##_array)                     \
     {                                                                                  \
-        if (prefix##_array->count < prefix##_array->capacity)                          \
+        const size_t new_capacity =                                                    \
+            prefix##_array->count ? prefix##_array->count : 1;                         \
+                                                                                       \
+        if (new_capacity == prefix##_array->capacity                                   \
+            || prefix##_array_is_inline_impl(prefix##_array))                          \
             return true;                                                               \
                                                                                        \
-        if (prefix##_array->capacity > SIZE_MAX / 2)                                   \
+        /* A spilled single-allocation array moves back once it fits again */          \
+        if (new_capacity <= prefix##_array->inline_capacity)                           \
         {                                                                              \
-            fprintf(                                                                   \
-                stderr,                                                                \
-                "%s: Capacity (%zu) cannot be doubled without overflow. "              \
-                "Max allowed is %zu entries.\n",                                       \
+            memcpy(                                                                    \
+                prefix##_array->inline_data,                                           \
+                prefix##_array->data,                                                  \
+                prefix##_array->count * sizeof(*prefix##_array->data));                \
+            ARRAY_STATS_ADD_IMPL(                                                      \
+                prefix##_array,                                                        \
+                bytes_moved,                                                           \
+                prefix##_array->count * sizeof(*prefix##_array->data));                \
+            array_allocator_deallocate_impl(                                           \
+                prefix##_array->allocator, prefix##_array->data);                      \
+            prefix##_array->data = prefix##_array->inline_data;                        \
+            prefix##_array->capacity = prefix##_array->inline_capacity;                \
+                                                                                       \
+            return true;                                                               \
+        }                                                                              \
+                                                                                       \
+        return prefix##_array_resize_impl(prefix##_array, new_capacity);               \
+    }                                                                                  \
+                                                                                       \
+    static inline bool prefix##_array_grow_impl(                                       \
+        name##Array *prefix##_array, size_t additional)                                \
+    {                                                                                  \
+        if (additional <= prefix##_array->capacity - prefix##_array->count)            \
+            return true;                                                               \
+                                                                                       \
+        if (additional > SIZE_MAX - prefix##_array->count)                             \
+        {                                                                              \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_OVERFLOW);           \
+            ARRAY_MACROS_REPORT(                                                       \
+                "%s: Adding %zu entries to %zu would overflow\n",                      \
                 __func__,                                                              \
-                prefix##_array->capacity,                                              \
-                SIZE_MAX / 2);                                                         \
+                additional,                                                            \
+                prefix##_array->count);                                                \
             return false;                                                              \
         }                                                                              \
                                                                                        \
-        const size_t new_capacity = prefix##_array->capacity * 2;                      \
+        const size_t required = prefix##_array->count + additional;                    \
+        size_t new_capacity = prefix##_array->capacity;                                \
+                                                                                       \
+        while (new_capacity < required)                                                \
+        {                                                                              \
+            const size_t next_capacity = growth(new_capacity);                         \
+                                                                                       \
+            if (next_capacity <= new_capacity)                                         \
+            {                                                                          \
+                ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_OVERFLOW);       \
+                ARRAY_MACROS_REPORT(                                                   \
+                    "%s: Capacity (%zu) cannot grow without overflow\n",               \
+                    __func__,                                                          \
+                    new_capacity);                                                     \
+                return false;                                                          \
+            }                                                                          \
+                                                                                       \
+            new_capacity = next_capacity;                                              \
+        }                                                                              \
+                                                                                       \
+        return prefix##_array_resize_impl(prefix##_array, new_capacity);               \
+    }                                                                                  \
                                                                                        \
+    static inline bool prefix##_array_resize_impl(                                     \
+        name##Array *prefix##_array, size_t new_capacity)                              \
+    {                                                                                  \
         if (new_capacity > SIZE_MAX / sizeof(*prefix##_array->data))                   \
         {                                                                              \
-            fprintf(                                                                   \
-                stderr,                                                                \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_OVERFLOW);           \
+            ARRAY_MACROS_REPORT(                                                       \
                 "%s: Increasing capacity would overflow malloc. "                      \
                 "Max capacity in bytes is %zu\n",                                      \
                 __func__,                                                              \
@@ -284,18 +780,46 @@
             return false;                                                              \
         }                                                                              \
                                                                                        \
-        type *new_data = realloc(                                                      \
-            prefix##_array->data,                                                      \
-            new_capacity * sizeof(*prefix##_array->data));                             \
+        type *new_data;                                                                \
+                                                                                       \
+        if (prefix##_array_is_inline_impl(prefix##_array))                             \
+        {                                                                              \
+            new_data = array_allocator_allocate_impl(                                  \
+                prefix##_array->allocator,                                             \
+                new_capacity * sizeof(*prefix##_array->data));                         \
+            if (new_data)                                                              \
+            {                                                                          \
+                memcpy(                                                                \
+                    new_data,                                                          \
+                    prefix##_array->data,                                              \
+                    prefix##_array->count * sizeof(*prefix##_array->data));            \
+                ARRAY_STATS_ADD_IMPL(                                                  \
+                    prefix##_array,                                                    \
+                    bytes_moved,                                                       \
+                    prefix##_array->count * sizeof(*prefix##_array->data));            \
+            }                                                                          \
+        }                                                                              \
+        else                                                                           \
+        {                                                                              \
+            new_data = array_allocator_reallocate_impl(                                \
+                prefix##_array->allocator,                                             \
+                prefix##_array->data,                                                  \
+                prefix##_array->capacity * sizeof(*prefix##_array->data),              \
+                new_capacity * sizeof(*prefix##_array->data));                         \
+        }                                                                              \
                                                                                        \
         if (!new_data)                                                                 \
         {                                                                              \
-            perror(#prefix "_array_grow_impl: Error with realloc");                    \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_ALLOCATION);         \
+            ARRAY_MACROS_REPORT_ERRNO(                                                 \
+                #prefix "_array_resize_impl: Error with realloc");                     \
             return false;                                                              \
         }                                                                              \
                                                                                        \
         prefix##_array->data = new_data;                                               \
         prefix##_array->capacity = new_capacity;                                       \
+        ARRAY_STATS_ADD_IMPL(prefix##_array, reallocs, 1);                             \
+        ARRAY_STATS_PEAK_IMPL(prefix##_array);                                         \
                                                                                        \
         return true;                                                                   \
     }
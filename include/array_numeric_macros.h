@@ -0,0 +1,451 @@
+/*
+ * array-macros
+ * Copyright (C) 2025  Thomas George Hodgkinson
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARRAY_MACROS_ARRAY_NUMERIC_MACROS_H
+#define ARRAY_MACROS_ARRAY_NUMERIC_MACROS_H
+
+#include <limits.h> // for CHAR_BIT
+#include <stdbool.h>
+#include <stddef.h> // for size_t
+#include <string.h>
+
+#include "array_macros.h"
+
+/*
+ * Bulk kernels for arrays of arithmetic types (int, float, double,
+ * int64_t, ...). With GCC or Clang they are written with vector
+ * extensions, so the target flags pick the instruction set: 32-byte
+ * vectors with -mavx, 16-byte vectors with SSE2 or NEON. Other compilers,
+ * or ARRAY_NUMERIC_VECTOR_BYTES defined as 0, get plain scalar loops.
+ * Vector sums add in a different order, so floating-point results may
+ * differ from a sequential sum in the last bits.
+ *
+ * sum accumulates in the element type, so the caller must make sure the
+ * total fits: signed char and short sums wrap on common targets, and
+ * overflowing int or int64_t is undefined. Copy narrow data into a wider
+ * array first when the total may not fit. add fails with
+ * ARRAY_ERROR_TYPE_SIZE_MISMATCH when the two counts differ.
+ *
+ * DEFINE_ARRAY_NUMERIC needs the full struct, so expand it after
+ * DEFINE_ARRAY_STRUCT.
+ */
+
+#ifndef ARRAY_NUMERIC_VECTOR_BYTES
+#if defined(__AVX__)
+#define ARRAY_NUMERIC_VECTOR_BYTES 32
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+#define ARRAY_NUMERIC_VECTOR_BYTES 16
+#else
+#define ARRAY_NUMERIC_VECTOR_BYTES 0
+#endif
+#endif
+
+#if defined(__GNUC__) && ARRAY_NUMERIC_VECTOR_BYTES > 0
+
+/*
+ * Lane counters are as wide as the element, so they are flushed before a
+ * signed lane can overflow: every 127 steps for 8-bit lanes, 32767 for
+ * 16-bit lanes and 2^20 for wider ones.
+ */
+#define ARRAY_NUMERIC_COUNT_FLUSH_INTERVAL(type) \
+    (sizeof(type) >= 4                           \
+         ? (size_t)1 << 20                       \
+         : ((size_t)1 << (sizeof(type) * CHAR_BIT - 1)) - 1)
+
+#define DEFINE_ARRAY_NUMERIC_KERNELS_IMPL(prefix, type)                             \
+    typedef type prefix##_array_vector_impl                                         \
+        __attribute__((vector_size(ARRAY_NUMERIC_VECTOR_BYTES)));                   \
+    typedef __typeof__(                                                             \
+        (prefix##_array_vector_impl){0} == (prefix##_array_vector_impl){0})         \
+        prefix##_array_mask_impl;                                                   \
+                                                                                    \
+    enum                                                                            \
+    {                                                                               \
+        prefix##_array_lanes_impl =                                                 \
+            ARRAY_NUMERIC_VECTOR_BYTES / sizeof(type)                               \
+    };                                                                              \
+                                                                                    \
+    static inline prefix##_array_vector_impl prefix##_array_load_impl(              \
+        const type *data)                                                           \
+    {                                                                               \
+        prefix##_array_vector_impl vector;                                          \
+        memcpy(&vector, data, sizeof(vector));                                      \
+        return vector;                                                              \
+    }                                                                               \
+                                                                                    \
+    static inline void prefix##_array_store_impl(                                   \
+        type *data, prefix##_array_vector_impl vector)                              \
+    {                                                                               \
+        memcpy(data, &vector, sizeof(vector));                                      \
+    }                                                                               \
+                                                                                    \
+    static inline prefix##_array_vector_impl prefix##_array_splat_impl(             \
+        type value)                                                                 \
+    {                                                                               \
+        return (prefix##_array_vector_impl){0} + value;                             \
+    }                                                                               \
+                                                                                    \
+    static inline bool prefix##_array_find_kernel_impl(                             \
+        const type *data, size_t count, type value, size_t *out_index)              \
+    {                                                                               \
+        const prefix##_array_vector_impl needle =                                   \
+            prefix##_array_splat_impl(value);                                       \
+        size_t i = 0;                                                               \
+                                                                                    \
+        for (; i + prefix##_array_lanes_impl <= count;                              \
+             i += prefix##_array_lanes_impl)                                        \
+        {                                                                           \
+            const prefix##_array_mask_impl mask =                                   \
+                prefix##_array_load_impl(&data[i]) == needle;                       \
+                                                                                    \
+            for (size_t lane = 0; lane < prefix##_array_lanes_impl; lane++)         \
+            {                                                                       \
+                if (mask[lane])                                                     \
+                {                                                                   \
+                    *out_index = i + lane;                                          \
+                    return true;                                                    \
+                }                                                                   \
+            }                                                                       \
+        }                                                                           \
+                                                                                    \
+        for (; i < count; i++)                                                      \
+        {                                                                           \
+            if (data[i] == value)                                                   \
+            {                                                                       \
+                *out_index = i;                                                     \
+                return true;                                                        \
+            }                                                                       \
+        }                                                                           \
+                                                                                    \
+        return false;                                                               \
+    }                                                                               \
+                                                                                    \
+    static inline size_t prefix##_array_count_kernel_impl(                          \
+        const type *data, size_t count, type value)                                 \
+    {                                                                               \
+        const prefix##_array_vector_impl needle =                                   \
+            prefix##_array_splat_impl(value);                                       \
+        size_t total = 0;                                                           \
+        size_t i = 0;                                                               \
+                                                                                    \
+        while (i + prefix##_array_lanes_impl <= count)                              \
+        {                                                                           \
+            prefix##_array_mask_impl matches =                                      \
+                (prefix##_array_vector_impl){0} != (prefix##_array_vector_impl){0}; \
+            size_t steps = 0;                                                       \
+                                                                                    \
+            /* Each equal lane is -1, so subtracting the mask counts up. */         \
+            for (; i + prefix##_array_lanes_impl <= count                           \
+                   && steps < ARRAY_NUMERIC_COUNT_FLUSH_INTERVAL(type);             \
+                 i += prefix##_array_lanes_impl, steps++)                           \
+                matches -= prefix##_array_load_impl(&data[i]) == needle;            \
+                                                                                    \
+            for (size_t lane = 0; lane < prefix##_array_lanes_impl; lane++)         \
+                total += (size_t)matches[lane];                                     \
+        }                                                                           \
+                                                                                    \
+        for (; i < count; i++)                                                      \
+            total += data[i] == value;                                              \
+                                                                                    \
+        return total;                                                               \
+    }                                                                               \
+                                                                                    \
+    static inline type prefix##_array_sum_kernel_impl(                              \
+        const type *data, size_t count)                                             \
+    {                                                                               \
+        prefix##_array_vector_impl sums = {0};                                      \
+        type total = 0;                                                             \
+        size_t i = 0;                                                               \
+                                                                                    \
+        for (; i + prefix##_array_lanes_impl <= count;                              \
+             i += prefix##_array_lanes_impl)                                        \
+            sums += prefix##_array_load_impl(&data[i]);                             \
+                                                                                    \
+        for (size_t lane = 0; lane < prefix##_array_lanes_impl; lane++)             \
+            total += sums[lane];                                                    \
+                                                                                    \
+        for (; i < count; i++)                                                      \
+            total += data[i];                                                       \
+                                                                                    \
+        return total;                                                               \
+    }                                                                               \
+                                                                                    \
+    static inline type prefix##_array_extreme_kernel_impl(                          \
+        const type *data, size_t count, bool want_max)                              \
+    {                                                                               \
+        type result = data[0];                                                      \
+        size_t i = 0;                                                               \
+                                                                                    \
+        if (count >= prefix##_array_lanes_impl)                                     \
+        {                                                                           \
+            prefix##_array_vector_impl best = prefix##_array_load_impl(data);       \
+                                                                                    \
+            for (i = prefix##_array_lanes_impl;                                     \
+                 i + prefix##_array_lanes_impl <= count;                            \
+                 i += prefix##_array_lanes_impl)                                    \
+            {                                                                       \
+                const prefix##_array_vector_impl vector =                           \
+                    prefix##_array_load_impl(&data[i]);                             \
+                const prefix##_array_mask_impl better = want_max                    \
+                    ? vector > best                                                 \
+                    : vector < best;                                                \
+                                                                                    \
+                /* Blend through the mask, as C has no vector ?: operator. */       \
+                best = (prefix##_array_vector_impl)(                                \
+                    ((prefix##_array_mask_impl)vector & better)                     \
+                    | ((prefix##_array_mask_impl)best & ~better));                  \
+            }                                                                       \
+                                                                                    \
+            result = best[0];                                                       \
+            for (size_t lane = 1; lane < prefix##_array_lanes_impl; lane++)         \
+            {                                                                       \
+                if (want_max ? best[lane] > result : best[lane] < result)           \
+                    result = best[lane];                                            \
+            }                                                                       \
+        }                                                                           \
+                                                                                    \
+        for (; i < count; i++)                                                      \
+        {                                                                           \
+            if (want_max ? data[i] > result : data[i] < result)                     \
+                result = data[i];                                                   \
+        }                                                                           \
+                                                                                    \
+        return result;                                                              \
+    }                                                                               \
+                                                                                    \
+    static inline void prefix##_array_fill_kernel_impl(                             \
+        type *data, size_t count, type value)                                       \
+    {                                                                               \
+        const prefix##_array_vector_impl vector =                                   \
+            prefix##_array_splat_impl(value);                                       \
+        size_t i = 0;                                                               \
+                                                                                    \
+        for (; i + prefix##_array_lanes_impl <= count;                              \
+             i += prefix##_array_lanes_impl)                                        \
+            prefix##_array_store_impl(&data[i], vector);                            \
+                                                                                    \
+        for (; i < count; i++)                                                      \
+            data[i] = value;                                                        \
+    }                                                                               \
+                                                                                    \
+    static inline void prefix##_array_add_kernel_impl(                              \
+        type *data, const type *other, size_t count)                                \
+    {                                                                               \
+        size_t i = 0;                                                               \
+                                                                                    \
+        for (; i + prefix##_array_lanes_impl <= count;                              \
+             i += prefix##_array_lanes_impl)                                        \
+            prefix##_array_store_impl(                                              \
+                &data[i],                                                           \
+                prefix##_array_load_impl(&data[i])                                  \
+                    + prefix##_array_load_impl(&other[i]));                         \
+                                                                                    \
+        for (; i < count; i++)                                                      \
+            data[i] += other[i];                                                    \
+    }                                                                               \
+                                                                                    \
+    static inline void prefix##_array_scale_kernel_impl(                            \
+        type *data, size_t count, type factor)                                      \
+    {                                                                               \
+        const prefix##_array_vector_impl vector =                                   \
+            prefix##_array_splat_impl(factor);                                      \
+        size_t i = 0;                                                               \
+                                                                                    \
+        for (; i + prefix##_array_lanes_impl <= count;                              \
+             i += prefix##_array_lanes_impl)                                        \
+            prefix##_array_store_impl(                                              \
+                &data[i], prefix##_array_load_impl(&data[i]) * vector);             \
+                                                                                    \
+        for (; i < count; i++)                                                      \
+            data[i] *= factor;                                                      \
+    }
+
+#else
+
+#define DEFINE_ARRAY_NUMERIC_KERNELS_IMPL(prefix, type)                \
+    static inline bool prefix##_array_find_kernel_impl(                \
+        const type *data, size_t count, type value, size_t *out_index) \
+    {                                                                  \
+        for (size_t i = 0; i < count; i++)                             \
+        {                                                              \
+            if (data[i] == value)                                      \
+            {                                                          \
+                *out_index = i;                                        \
+                return true;                                           \
+            }                                                          \
+        }                                                              \
+                                                                       \
+        return false;                                                  \
+    }                                                                  \
+                                                                       \
+    static inline size_t prefix##_array_count_kernel_impl(             \
+        const type *data, size_t count, type value)                    \
+    {                                                                  \
+        size_t total = 0;                                              \
+                                                                       \
+        for (size_t i = 0; i < count; i++)                             \
+            total += data[i] == value;                                 \
+                                                                       \
+        return total;                                                  \
+    }                                                                  \
+                                                                       \
+    static inline type prefix##_array_sum_kernel_impl(                 \
+        const type *data, size_t count)                                \
+    {                                                                  \
+        type total = 0;                                                \
+                                                                       \
+        for (size_t i = 0; i < count; i++)                             \
+            total += data[i];                                          \
+                                                                       \
+        return total;                                                  \
+    }                                                                  \
+                                                                       \
+    static inline type prefix##_array_extreme_kernel_impl(             \
+        const type *data, size_t count, bool want_max)                 \
+    {                                                                  \
+        type result = data[0];                                         \
+                                                                       \
+        for (size_t i = 1; i < count; i++)                             \
+        {                                                              \
+            if (want_max ? data[i] > result : data[i] < result)        \
+                result = data[i];                                      \
+        }                                                              \
+                                                                       \
+        return result;                                                 \
+    }                                                                  \
+                                                                       \
+    static inline void prefix##_array_fill_kernel_impl(                \
+        type *data, size_t count, type value)                          \
+    {                                                                  \
+        for (size_t i = 0; i < count; i++)                             \
+            data[i] = value;                                           \
+    }                                                                  \
+                                                                       \
+    static inline void prefix##_array_add_kernel_impl(                 \
+        type *data, const type *other, size_t count)                   \
+    {                                                                  \
+        for (size_t i = 0; i < count; i++)                             \
+            data[i] += other[i];                                       \
+    }                                                                  \
+                                                                       \
+    static inline void prefix##_array_scale_kernel_impl(               \
+        type *data, size_t count, type factor)                         \
+    {                                                                  \
+        for (size_t i = 0; i < count; i++)                             \
+            data[i] *= factor;                                         \
+    }
+
+#endif
+
+#define DECLARE_ARRAY_NUMERIC(prefix, name, type)                                  \
+    bool prefix##_array_find(                                                      \
+        const name##Array *prefix##_array, type value, size_t *out_index);         \
+    size_t prefix##_array_count_of(const name##Array *prefix##_array, type value); \
+    bool prefix##_array_min(name##Array *prefix##_array, type *out_item);          \
+    bool prefix##_array_max(name##Array *prefix##_array, type *out_item);          \
+    type prefix##_array_sum(const name##Array *prefix##_array);                    \
+    void prefix##_array_fill(name##Array *prefix##_array, type value);             \
+    bool prefix##_array_add(                                                       \
+        name##Array *prefix##_array, const name##Array *other);                    \
+    void prefix##_array_scale(name##Array *prefix##_array, type factor);
+
+#define DEFINE_ARRAY_NUMERIC(prefix, name, type)                                  \
+    DEFINE_ARRAY_NUMERIC_KERNELS_IMPL(prefix, type)                               \
+                                                                                  \
+    bool prefix##_array_find(                                                     \
+        const name##Array *prefix##_array, type value, size_t *out_index)         \
+    {                                                                             \
+        return prefix##_array_find_kernel_impl(                                   \
+            prefix##_array->data, prefix##_array->count, value, out_index);       \
+    }                                                                             \
+                                                                                  \
+    size_t prefix##_array_count_of(const name##Array *prefix##_array, type value) \
+    {                                                                             \
+        return prefix##_array_count_kernel_impl(                                  \
+            prefix##_array->data, prefix##_array->count, value);                  \
+    }                                                                             \
+                                                                                  \
+    bool prefix##_array_min(name##Array *prefix##_array, type *out_item)          \
+    {                                                                             \
+        if (prefix##_array->count == 0)                                           \
+        {                                                                         \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_EMPTY);         \
+            ARRAY_MACROS_REPORT("%s: Array is empty (count 0)\n", __func__);      \
+            return false;                                                         \
+        }                                                                         \
+                                                                                  \
+        *out_item = prefix##_array_extreme_kernel_impl(                           \
+            prefix##_array->data, prefix##_array->count, false);                  \
+                                                                                  \
+        return true;                                                              \
+    }                                                                             \
+                                                                                  \
+    bool prefix##_array_max(name##Array *prefix##_array, type *out_item)          \
+    {                                                                             \
+        if (prefix##_array->count == 0)                                           \
+        {                                                                         \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_EMPTY);         \
+            ARRAY_MACROS_REPORT("%s: Array is empty (count 0)\n", __func__);      \
+            return false;                                                         \
+        }                                                                         \
+                                                                                  \
+        *out_item = prefix##_array_extreme_kernel_impl(                           \
+            prefix##_array->data, prefix##_array->count, true);                   \
+                                                                                  \
+        return true;                                                              \
+    }                                                                             \
+                                                                                  \
+    type prefix##_array_sum(const name##Array *prefix##_array)                    \
+    {                                                                             \
+        return prefix##_array_sum_kernel_impl(                                    \
+            prefix##_array->data, prefix##_array->count);                         \
+    }                                                                             \
+                                                                                  \
+    void prefix##_array_fill(name##Array *prefix##_array, type value)             \
+    {                                                                             \
+        prefix##_array_fill_kernel_impl(                                          \
+            prefix##_array->data, prefix##_array->count, value);                  \
+    }                                                                             \
+                                                                                  \
+    bool prefix##_array_add(                                                      \
+        name##Array *prefix##_array, const name##Array *other)                    \
+    {                                                                             \
+        if (other->count != prefix##_array->count)                                \
+        {                                                                         \
+            ARRAY_SET_ERROR_IMPL(prefix##_array, ARRAY_ERROR_TYPE_SIZE_MISMATCH); \
+            ARRAY_MACROS_REPORT(                                                  \
+                "%s: Count (%zu) does not match (%zu)\n",                         \
+                __func__,                                                         \
+                other->count,                                                     \
+                prefix##_array->count);                                           \
+            return false;                                                         \
+        }                                                                         \
+                                                                                  \
+        prefix##_array_add_kernel_impl(                                           \
+            prefix##_array->data, other->data, prefix##_array->count);            \
+                                                                                  \
+        return true;                                                              \
+    }                                                                             \
+                                                                                  \
+    void prefix##_array_scale(name##Array *prefix##_array, type factor)           \
+    {                                                                             \
+        prefix##_array_scale_kernel_impl(                                         \
+            prefix##_array->data, prefix##_array->count, factor);                 \
+    }
+
+#endif // ARRAY_MACROS_ARRAY_NUMERIC_MACROS_H
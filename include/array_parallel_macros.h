@@ -0,0 +1,550 @@
+/*
+ * array-macros
+ * Copyright (C) 2025  Thomas George Hodgkinson
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARRAY_MACROS_ARRAY_PARALLEL_MACROS_H
+#define ARRAY_MACROS_ARRAY_PARALLEL_MACROS_H
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h> // for size_t
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h> // for sysconf
+
+#include "array_macros.h"
+
+/*
+ * Parallel passes over an array, run on a reusable pool of pthreads.
+ *
+ * A pass splits the array into chunks of at least
+ * ARRAY_PARALLEL_MIN_CHUNK elements, about ARRAY_PARALLEL_CHUNKS_PER_THREAD
+ * per thread. Threads claim the next chunk from a shared atomic counter,
+ * so a thread that finishes early takes work that would otherwise wait
+ * behind a slow one. The calling thread works alongside the pool, and a
+ * NULL pool runs the pass on the calling thread alone.
+ *
+ * reduce combines each chunk in order and then the chunk results in
+ * order, so combine must be associative but need not be commutative.
+ * filter is stable and runs in O(n).
+ *
+ * Callbacks run concurrently and must not touch the array except through
+ * their arguments. A pool runs one pass at a time.
+ *
+ * DEFINE_ARRAY_PARALLEL needs the full struct, so expand it after
+ * DEFINE_ARRAY_STRUCT.
+ */
+
+#ifndef ARRAY_PARALLEL_MIN_CHUNK
+#define ARRAY_PARALLEL_MIN_CHUNK ((size_t)4096)
+#endif
+
+#ifndef ARRAY_PARALLEL_CHUNKS_PER_THREAD
+#define ARRAY_PARALLEL_CHUNKS_PER_THREAD ((size_t)8)
+#endif
+
+typedef void (*ArrayParallelTask)(void *context, size_t begin, size_t end);
+
+typedef struct array_thread_pool
+{
+    pthread_t *workers;
+    size_t worker_count;
+    pthread_mutex_t mutex;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    size_t generation;
+    size_t active;
+    bool stopping;
+    ArrayParallelTask task;
+    void *context;
+    size_t count;
+    size_t chunk_size;
+    atomic_size_t next;
+} ArrayThreadPool;
+
+static inline void array_thread_pool_drain_impl(ArrayThreadPool *pool)
+{
+    for (;;)
+    {
+        const size_t begin = atomic_fetch_add_explicit(
+            &pool->next, pool->chunk_size, memory_order_relaxed);
+        if (begin >= pool->count)
+            return;
+
+        const size_t end = pool->count - begin < pool->chunk_size
+            ? pool->count
+            : begin + pool->chunk_size;
+        pool->task(pool->context, begin, end);
+    }
+}
+
+static inline void *array_thread_pool_worker_impl(void *arg)
+{
+    ArrayThreadPool *pool = arg;
+    size_t generation = 0;
+
+    pthread_mutex_lock(&pool->mutex);
+    for (;;)
+    {
+        while (!pool->stopping && pool->generation == generation)
+            pthread_cond_wait(&pool->work_ready, &pool->mutex);
+
+        if (pool->stopping)
+            break;
+
+        generation = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
+
+        array_thread_pool_drain_impl(pool);
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->active == 0)
+            pthread_cond_signal(&pool->work_done);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    return NULL;
+}
+
+static inline void array_thread_pool_stop_impl(
+    ArrayThreadPool *pool, size_t started)
+{
+    pthread_mutex_lock(&pool->mutex);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (size_t i = 0; i < started; i++)
+        pthread_join(pool->workers[i], NULL);
+
+    pthread_cond_destroy(&pool->work_done);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_mutex_destroy(&pool->mutex);
+    free(pool->workers);
+    free(pool);
+}
+
+/*
+ * thread_count includes the calling thread, so a pool of n threads starts
+ * n - 1 workers. 0 uses one thread per online processor. If a lock or a
+ * worker cannot be set up, whatever was already started is torn down,
+ * errno is set to the pthread error and NULL is returned.
+ */
+static inline ArrayThreadPool *array_thread_pool_create(size_t thread_count)
+{
+    if (!thread_count)
+    {
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = online > 0 ? (size_t)online : 1;
+    }
+
+    ArrayThreadPool *pool = malloc(sizeof(*pool));
+    if (!pool)
+    {
+        ARRAY_MACROS_REPORT_ERRNO("array_thread_pool allocation failure");
+        return NULL;
+    }
+
+    pool->worker_count = thread_count - 1;
+    pool->workers = malloc(
+        (pool->worker_count ? pool->worker_count : 1) * sizeof(pthread_t));
+    if (!pool->workers)
+    {
+        ARRAY_MACROS_REPORT_ERRNO(
+            "array_thread_pool workers allocation failure");
+        free(pool);
+        return NULL;
+    }
+
+    /* Each step undoes the ones before it if it fails. */
+    int result = pthread_mutex_init(&pool->mutex, NULL);
+    if (!result && (result = pthread_cond_init(&pool->work_ready, NULL)))
+        pthread_mutex_destroy(&pool->mutex);
+    if (!result && (result = pthread_cond_init(&pool->work_done, NULL)))
+    {
+        pthread_cond_destroy(&pool->work_ready);
+        pthread_mutex_destroy(&pool->mutex);
+    }
+
+    if (result)
+    {
+        ARRAY_MACROS_REPORT(
+            "%s: Error initialising the pool's locks: %s\n",
+            __func__,
+            strerror(result));
+        free(pool->workers);
+        free(pool);
+        errno = result;
+        return NULL;
+    }
+
+    pool->generation = 0;
+    pool->active = 0;
+    pool->stopping = false;
+    pool->task = NULL;
+    pool->context = NULL;
+    pool->count = 0;
+    pool->chunk_size = 1;
+    atomic_init(&pool->next, 0);
+
+    for (size_t i = 0; i < pool->worker_count; i++)
+    {
+        result = pthread_create(
+            &pool->workers[i], NULL, array_thread_pool_worker_impl, pool);
+        if (result)
+        {
+            ARRAY_MACROS_REPORT(
+                "%s: Error starting worker %zu: %s\n",
+                __func__,
+                i,
+                strerror(result));
+            array_thread_pool_stop_impl(pool, i);
+            errno = result;
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+static inline void array_thread_pool_free(ArrayThreadPool *pool)
+{
+    array_thread_pool_stop_impl(pool, pool->worker_count);
+}
+
+static inline size_t array_thread_pool_get_thread_count(
+    const ArrayThreadPool *pool)
+{
+    return pool->worker_count + 1;
+}
+
+static inline size_t array_thread_pool_chunk_size_impl(
+    const ArrayThreadPool *pool, size_t count)
+{
+    if (!pool)
+        return count ? count : 1;
+
+    const size_t chunk_size =
+        count / (array_thread_pool_get_thread_count(pool)
+                 * ARRAY_PARALLEL_CHUNKS_PER_THREAD);
+
+    return chunk_size < ARRAY_PARALLEL_MIN_CHUNK
+        ? ARRAY_PARALLEL_MIN_CHUNK
+        : chunk_size;
+}
+
+static inline size_t array_thread_pool_chunk_count_impl(
+    size_t count, size_t chunk_size)
+{
+    return count / chunk_size + (count % chunk_size != 0);
+}
+
+/* Runs task over [0, count) in chunks and returns once all have finished. */
+static inline void array_thread_pool_run_impl(
+    ArrayThreadPool *pool,
+    size_t count,
+    size_t chunk_size,
+    ArrayParallelTask task,
+    void *context)
+{
+    if (!pool || !pool->worker_count || count <= chunk_size)
+    {
+        for (size_t begin = 0; begin < count; begin += chunk_size)
+            task(context,
+                 begin,
+                 count - begin < chunk_size ? count : begin + chunk_size);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    pool->task = task;
+    pool->context = context;
+    pool->count = count;
+    pool->chunk_size = chunk_size;
+    atomic_store_explicit(&pool->next, 0, memory_order_relaxed);
+    pool->active = pool->worker_count;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->mutex);
+
+    array_thread_pool_drain_impl(pool);
+
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->active)
+        pthread_cond_wait(&pool->work_done, &pool->mutex);
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+/*
+ * reduce seeds every chunk with identity, so combine(identity, x) must
+ * equal x: 0 for a sum, 1 for a product. An empty array reduces to
+ * identity. reduce records ARRAY_ERROR_TYPE_ALLOCATION on the array if
+ * it cannot allocate the per-chunk results.
+ */
+#define DECLARE_ARRAY_PARALLEL(prefix, name, type)                   \
+    void prefix##_array_parallel_for_each(                           \
+        name##Array *prefix##_array,                                 \
+        ArrayThreadPool *pool,                                       \
+        void (*fn)(type *item, void *context),                       \
+        void *context);                                              \
+    bool prefix##_array_parallel_map(                                \
+        const name##Array *prefix##_array,                           \
+        name##Array *dest,                                           \
+        ArrayThreadPool *pool,                                       \
+        type (*fn)(type item, void *context),                        \
+        void *context);                                              \
+    bool prefix##_array_parallel_reduce(                             \
+        name##Array *prefix##_array,                                 \
+        ArrayThreadPool *pool,                                       \
+        type identity,                                               \
+        type (*combine)(type accumulator, type item, void *context), \
+        void *context,                                               \
+        type *out_result);                                           \
+    bool prefix##_array_parallel_filter(                             \
+        name##Array *prefix##_array,                                 \
+        ArrayThreadPool *pool,                                       \
+        bool (*predicate)(type item, void *context),                 \
+        void *context);
+
+#define DEFINE_ARRAY_PARALLEL(prefix, name, type)                           \
+    typedef struct prefix##_array_parallel_impl                             \
+    {                                                                       \
+        const type *src;                                                    \
+        type *dest;                                                         \
+        size_t chunk_size;                                                  \
+        size_t *counts;                                                     \
+        type *partials;                                                     \
+        type identity;                                                      \
+        void (*for_each_fn)(type *item, void *context);                     \
+        type (*map_fn)(type item, void *context);                           \
+        type (*combine)(type accumulator, type item, void *context);        \
+        bool (*predicate)(type item, void *context);                        \
+        void *context;                                                      \
+    } prefix##_array_parallel_impl;                                         \
+                                                                            \
+    static void prefix##_array_for_each_task_impl(                          \
+        void *arg, size_t begin, size_t end)                                \
+    {                                                                       \
+        const prefix##_array_parallel_impl *pass = arg;                     \
+                                                                            \
+        for (size_t i = begin; i < end; i++)                                \
+            pass->for_each_fn(&pass->dest[i], pass->context);               \
+    }                                                                       \
+                                                                            \
+    static void prefix##_array_map_task_impl(                               \
+        void *arg, size_t begin, size_t end)                                \
+    {                                                                       \
+        const prefix##_array_parallel_impl *pass = arg;                     \
+                                                                            \
+        for (size_t i = begin; i < end; i++)                                \
+            pass->dest[i] = pass->map_fn(pass->src[i], pass->context);      \
+    }                                                                       \
+                                                                            \
+    static void prefix##_array_reduce_task_impl(                            \
+        void *arg, size_t begin, size_t end)                                \
+    {                                                                       \
+        const prefix##_array_parallel_impl *pass = arg;                     \
+        type accumulator = pass->identity;                                  \
+                                                                            \
+        for (size_t i = begin; i < end; i++)                                \
+            accumulator =                                                   \
+                pass->combine(accumulator, pass->src[i], pass->context);    \
+                                                                            \
+        pass->partials[begin / pass->chunk_size] = accumulator;             \
+    }                                                                       \
+                                                                            \
+    /* Compacts each chunk in place; the chunks are joined afterwards. */   \
+    static void prefix##_array_filter_task_impl(                            \
+        void *arg, size_t begin, size_t end)                                \
+    {                                                                       \
+        const prefix##_array_parallel_impl *pass = arg;                     \
+        size_t kept = begin;                                                \
+                                                                            \
+        for (size_t i = begin; i < end; i++)                                \
+        {                                                                   \
+            if (pass->predicate(pass->dest[i], pass->context))              \
+                pass->dest[kept++] = pass->dest[i];                         \
+        }                                                                   \
+                                                                            \
+        pass->counts[begin / pass->chunk_size] = kept - begin;              \
+    }                                                                       \
+                                                                            \
+    void prefix##_array_parallel_for_each(                                  \
+        name##Array *prefix##_array,                                        \
+        ArrayThreadPool *pool,                                              \
+        void (*fn)(type *item, void *context),                              \
+        void *context)                                                      \
+    {                                                                       \
+        prefix##_array_parallel_impl pass = {                               \
+            .dest = prefix##_array->data,                                   \
+            .chunk_size = array_thread_pool_chunk_size_impl(                \
+                pool, prefix##_array->count),                               \
+            .for_each_fn = fn,                                              \
+            .context = context,                                             \
+        };                                                                  \
+                                                                            \
+        array_thread_pool_run_impl(                                         \
+            pool,                                                           \
+            prefix##_array->count,                                          \
+            pass.chunk_size,                                                \
+            prefix##_array_for_each_task_impl,                              \
+            &pass);                                                         \
+    }                                                                       \
+                                                                            \
+    bool prefix##_array_parallel_map(                                       \
+        const name##Array *prefix##_array,                                  \
+        name##Array *dest,                                                  \
+        ArrayThreadPool *pool,                                              \
+        type (*fn)(type item, void *context),                               \
+        void *context)                                                      \
+    {                                                                       \
+        const size_t count = prefix##_array->count;                         \
+                                                                            \
+        if (dest != prefix##_array && !prefix##_array_reserve(dest, count)) \
+            return false;                                                   \
+                                                                            \
+        prefix##_array_parallel_impl pass = {                               \
+            .src = prefix##_array->data,                                    \
+            .dest = dest->data,                                             \
+            .chunk_size = array_thread_pool_chunk_size_impl(pool, count),   \
+            .map_fn = fn,                                                   \
+            .context = context,                                             \
+        };                                                                  \
+                                                                            \
+        array_thread_pool_run_impl(                                         \
+            pool,                                                           \
+            count,                                                          \
+            pass.chunk_size,                                                \
+            prefix##_array_map_task_impl,                                   \
+            &pass);                                                         \
+        dest->count = count;                                                \
+                                                                            \
+        return true;                                                        \
+    }                                                                       \
+                                                                            \
+    bool prefix##_array_parallel_reduce(                                    \
+        name##Array *prefix##_array,                                        \
+        ArrayThreadPool *pool,                                              \
+        type identity,                                                      \
+        type (*combine)(type accumulator, type item, void *context),        \
+        void *context,                                                      \
+        type *out_result)                                                   \
+    {                                                                       \
+        const size_t count = prefix##_array->count;                         \
+        prefix##_array_parallel_impl pass = {                               \
+            .src = prefix##_array->data,                                    \
+            .chunk_size = array_thread_pool_chunk_size_impl(pool, count),   \
+            .identity = identity,                                           \
+            .combine = combine,                                             \
+            .context = context,                                             \
+        };                                                                  \
+        const size_t chunk_count =                                          \
+            array_thread_pool_chunk_count_impl(count, pass.chunk_size);     \
+                                                                            \
+        if (!chunk_count)                                                   \
+        {                                                                   \
+            *out_result = identity;                                         \
+            return true;                                                    \
+        }                                                                   \
+                                                                            \
+        pass.partials = array_allocator_allocate_impl(                      \
+            prefix##_array->allocator, chunk_count * sizeof(type));         \
+        if (!pass.partials)                                                 \
+        {                                                                   \
+            ARRAY_SET_ERROR_IMPL(                                           \
+                prefix##_array, ARRAY_ERROR_TYPE_ALLOCATION);               \
+            ARRAY_MACROS_REPORT_ERRNO(                                      \
+                #prefix "_array_parallel_reduce: Error with allocation");   \
+            return false;                                                   \
+        }                                                                   \
+                                                                            \
+        array_thread_pool_run_impl(                                         \
+            pool,                                                           \
+            count,                                                          \
+            pass.chunk_size,                                                \
+            prefix##_array_reduce_task_impl,                                \
+            &pass);                                                         \
+                                                                            \
+        type result = pass.partials[0];                                     \
+        for (size_t i = 1; i < chunk_count; i++)                            \
+            result = combine(result, pass.partials[i], context);            \
+                                                                            \
+        array_allocator_deallocate_impl(                                    \
+            prefix##_array->allocator, pass.partials);                      \
+        *out_result = result;                                               \
+                                                                            \
+        return true;                                                        \
+    }                                                                       \
+                                                                            \
+    bool prefix##_array_parallel_filter(                                    \
+        name##Array *prefix##_array,                                        \
+        ArrayThreadPool *pool,                                              \
+        bool (*predicate)(type item, void *context),                        \
+        void *context)                                                      \
+    {                                                                       \
+        const size_t count = prefix##_array->count;                         \
+        prefix##_array_parallel_impl pass = {                               \
+            .dest = prefix##_array->data,                                   \
+            .chunk_size = array_thread_pool_chunk_size_impl(pool, count),   \
+            .predicate = predicate,                                         \
+            .context = context,                                             \
+        };                                                                  \
+        const size_t chunk_count =                                          \
+            array_thread_pool_chunk_count_impl(count, pass.chunk_size);     \
+                                                                            \
+        if (!chunk_count)                                                   \
+            return true;                                                    \
+                                                                            \
+        pass.counts = array_allocator_allocate_impl(                        \
+            prefix##_array->allocator, chunk_count * sizeof(size_t));       \
+        if (!pass.counts)                                                   \
+        {                                                                   \
+            ARRAY_SET_ERROR_IMPL(                                           \
+                prefix##_array, ARRAY_ERROR_TYPE_ALLOCATION);               \
+            ARRAY_MACROS_REPORT_ERRNO(                                      \
+                #prefix "_array_parallel_filter: Error with allocation");   \
+            return false;                                                   \
+        }                                                                   \
+                                                                            \
+        array_thread_pool_run_impl(                                         \
+            pool,                                                           \
+            count,                                                          \
+            pass.chunk_size,                                                \
+            prefix##_array_filter_task_impl,                                \
+            &pass);                                                         \
+                                                                            \
+        /* Each kept run moves left at most once, so the join is O(n). */   \
+        size_t kept = pass.counts[0];                                       \
+        for (size_t i = 1; i < chunk_count; i++)                            \
+        {                                                                   \
+            memmove(                                                        \
+                &prefix##_array->data[kept],                                \
+                &prefix##_array->data[i * pass.chunk_size],                 \
+                pass.counts[i] * sizeof(type));                             \
+            kept += pass.counts[i];                                         \
+        }                                                                   \
+                                                                            \
+        array_allocator_deallocate_impl(                                    \
+            prefix##_array->allocator, pass.counts);                        \
+        prefix##_array->count = kept;                                       \
+                                                                            \
+        return true;                                                        \
+    }
+
+#endif // ARRAY_MACROS_ARRAY_PARALLEL_MACROS_H
@@ -0,0 +1,268 @@
+/*
+ * array-macros
+ * Copyright (C) 2025  Thomas George Hodgkinson
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARRAY_MACROS_ARRAY_SORT_MACROS_H
+#define ARRAY_MACROS_ARRAY_SORT_MACROS_H
+
+#include <stdbool.h>
+#include <stddef.h> // for size_t
+
+#include "array_macros.h"
+
+/*
+ * Sorting and sorted lookup for an array instantiation. cmp_expr is an
+ * expression over two values of the element type named `a` and `b`. It
+ * must be negative, zero or positive as a orders before, equal to or
+ * after b, e.g. `(a > b) - (a < b)`. It is expanded in place, so the
+ * comparison is inlined into the generated code.
+ *
+ * DEFINE_ARRAY_SORT needs the full struct, so expand it after
+ * DEFINE_ARRAY_STRUCT.
+ */
+
+#define ARRAY_SORT_INSERTION_THRESHOLD 16
+
+#define DECLARE_ARRAY_SORT(prefix, name, type)                           \
+    void prefix##_array_sort(name##Array *prefix##_array);               \
+    size_t prefix##_array_lower_bound(                                   \
+        const name##Array *prefix##_array, type key);                    \
+    size_t prefix##_array_upper_bound(                                   \
+        const name##Array *prefix##_array, type key);                    \
+    bool prefix##_array_binary_search(                                   \
+        const name##Array *prefix##_array, type key, size_t *out_index); \
+    bool prefix##_array_insert_sorted(name##Array *prefix##_array, type item);
+
+#define DEFINE_ARRAY_SORT(prefix, name, type, cmp_expr)                           \
+    static inline int prefix##_array_compare_impl(type a, type b)                 \
+    {                                                                             \
+        return (cmp_expr);                                                        \
+    }                                                                             \
+                                                                                  \
+    static inline void prefix##_array_insertion_sort_impl(                        \
+        type *data, size_t count)                                                 \
+    {                                                                             \
+        for (size_t i = 1; i < count; i++)                                        \
+        {                                                                         \
+            const type item = data[i];                                            \
+            size_t j = i;                                                         \
+                                                                                  \
+            while (j > 0 && prefix##_array_compare_impl(item, data[j - 1]) < 0)   \
+            {                                                                     \
+                data[j] = data[j - 1];                                            \
+                j--;                                                              \
+            }                                                                     \
+                                                                                  \
+            data[j] = item;                                                       \
+        }                                                                         \
+    }                                                                             \
+                                                                                  \
+    static inline void prefix##_array_sift_down_impl(                             \
+        type *data, size_t root, size_t count)                                    \
+    {                                                                             \
+        const type item = data[root];                                             \
+                                                                                  \
+        for (;;)                                                                  \
+        {                                                                         \
+            size_t child = 2 * root + 1;                                          \
+                                                                                  \
+            if (child >= count)                                                   \
+                break;                                                            \
+                                                                                  \
+            if (child + 1 < count                                                 \
+                && prefix##_array_compare_impl(data[child], data[child + 1]) < 0) \
+                child++;                                                          \
+                                                                                  \
+            if (prefix##_array_compare_impl(item, data[child]) >= 0)              \
+                break;                                                            \
+                                                                                  \
+            data[root] = data[child];                                             \
+            root = child;                                                         \
+        }                                                                         \
+                                                                                  \
+        data[root] = item;                                                        \
+    }                                                                             \
+                                                                                  \
+    static inline void prefix##_array_heap_sort_impl(type *data, size_t count)    \
+    {                                                                             \
+        for (size_t i = count / 2; i > 0; i--)                                    \
+            prefix##_array_sift_down_impl(data, i - 1, count);                    \
+                                                                                  \
+        for (size_t end = count - 1; end > 0; end--)                              \
+        {                                                                         \
+            const type item = data[0];                                            \
+            data[0] = data[end];                                                  \
+            data[end] = item;                                                     \
+            prefix##_array_sift_down_impl(data, 0, end);                          \
+        }                                                                         \
+    }                                                                             \
+                                                                                  \
+    static inline void prefix##_array_sort_three_impl(                            \
+        type *data, size_t i, size_t j, size_t k)                                 \
+    {                                                                             \
+        type item;                                                                \
+                                                                                  \
+        if (prefix##_array_compare_impl(data[j], data[i]) < 0)                    \
+        {                                                                         \
+            item = data[i];                                                       \
+            data[i] = data[j];                                                    \
+            data[j] = item;                                                       \
+        }                                                                         \
+                                                                                  \
+        if (prefix##_array_compare_impl(data[k], data[j]) < 0)                    \
+        {                                                                         \
+            item = data[j];                                                       \
+            data[j] = data[k];                                                    \
+            data[k] = item;                                                       \
+                                                                                  \
+            if (prefix##_array_compare_impl(data[j], data[i]) < 0)                \
+            {                                                                     \
+                item = data[i];                                                   \
+                data[i] = data[j];                                                \
+                data[j] = item;                                                   \
+            }                                                                     \
+        }                                                                         \
+    }                                                                             \
+                                                                                  \
+    static void prefix##_array_introsort_impl(                                    \
+        type *data, size_t count, size_t depth)                                   \
+    {                                                                             \
+        while (count > ARRAY_SORT_INSERTION_THRESHOLD)                            \
+        {                                                                         \
+            if (!depth)                                                           \
+            {                                                                     \
+                prefix##_array_heap_sort_impl(data, count);                       \
+                return;                                                           \
+            }                                                                     \
+            depth--;                                                              \
+                                                                                  \
+            prefix##_array_sort_three_impl(data, 0, count / 2, count - 1);        \
+            const type pivot = data[count / 2];                                   \
+            size_t i = 0;                                                         \
+            size_t j = count - 1;                                                 \
+                                                                                  \
+            for (;;)                                                              \
+            {                                                                     \
+                while (prefix##_array_compare_impl(data[i], pivot) < 0)           \
+                    i++;                                                          \
+                while (prefix##_array_compare_impl(pivot, data[j]) < 0)           \
+                    j--;                                                          \
+                                                                                  \
+                if (i >= j)                                                       \
+                    break;                                                        \
+                                                                                  \
+                const type item = data[i];                                        \
+                data[i] = data[j];                                                \
+                data[j] = item;                                                   \
+                i++;                                                              \
+                j--;                                                              \
+            }                                                                     \
+                                                                                  \
+            /* Recurse into the smaller side to bound the stack depth. */         \
+            const size_t left_count = j + 1;                                      \
+            const size_t right_count = count - left_count;                        \
+                                                                                  \
+            if (left_count < right_count)                                         \
+            {                                                                     \
+                prefix##_array_introsort_impl(data, left_count, depth);           \
+                data += left_count;                                               \
+                count = right_count;                                              \
+            }                                                                     \
+            else                                                                  \
+            {                                                                     \
+                prefix##_array_introsort_impl(                                    \
+                    data + left_count, right_count, depth);                       \
+                count = left_count;                                               \
+            }                                                                     \
+        }                                                                         \
+                                                                                  \
+        prefix##_array_insertion_sort_impl(data, count);                          \
+    }                                                                             \
+                                                                                  \
+    void prefix##_array_sort(name##Array *prefix##_array)                         \
+    {                                                                             \
+        size_t depth = 0;                                                         \
+                                                                                  \
+        for (size_t n = prefix##_array->count; n > 1; n >>= 1)                    \
+            depth += 2;                                                           \
+                                                                                  \
+        prefix##_array_introsort_impl(                                            \
+            prefix##_array->data, prefix##_array->count, depth);                  \
+    }                                                                             \
+                                                                                  \
+    size_t prefix##_array_lower_bound(                                            \
+        const name##Array *prefix##_array, type key)                              \
+    {                                                                             \
+        size_t low = 0;                                                           \
+        size_t high = prefix##_array->count;                                      \
+                                                                                  \
+        while (low < high)                                                        \
+        {                                                                         \
+            const size_t mid = low + (high - low) / 2;                            \
+                                                                                  \
+            if (prefix##_array_compare_impl(prefix##_array->data[mid], key) < 0)  \
+                low = mid + 1;                                                    \
+            else                                                                  \
+                high = mid;                                                       \
+        }                                                                         \
+                                                                                  \
+        return low;                                                               \
+    }                                                                             \
+                                                                                  \
+    size_t prefix##_array_upper_bound(                                            \
+        const name##Array *prefix##_array, type key)                              \
+    {                                                                             \
+        size_t low = 0;                                                           \
+        size_t high = prefix##_array->count;                                      \
+                                                                                  \
+        while (low < high)                                                        \
+        {                                                                         \
+            const size_t mid = low + (high - low) / 2;                            \
+                                                                                  \
+            if (prefix##_array_compare_impl(key, prefix##_array->data[mid]) < 0)  \
+                high = mid;                                                       \
+            else                                                                  \
+                low = mid + 1;                                                    \
+        }                                                                         \
+                                                                                  \
+        return low;                                                               \
+    }                                                                             \
+                                                                                  \
+    bool prefix##_array_binary_search(                                            \
+        const name##Array *prefix##_array, type key, size_t *out_index)           \
+    {                                                                             \
+        const size_t index = prefix##_array_lower_bound(prefix##_array, key);     \
+                                                                                  \
+        if (index == prefix##_array->count                                        \
+            || prefix##_array_compare_impl(prefix##_array->data[index], key))     \
+            return false;                                                         \
+                                                                                  \
+        if (out_index)                                                            \
+            *out_index = index;                                                   \
+                                                                                  \
+        return true;                                                              \
+    }                                                                             \
+                                                                                  \
+    bool prefix##_array_insert_sorted(name##Array *prefix##_array, type item)     \
+    {                                                                             \
+        return prefix##_array_insert(                                             \
+            prefix##_array,                                                       \
+            prefix##_array_upper_bound(prefix##_array, item),                     \
+            item);                                                                \
+    }
+
+#endif // ARRAY_MACROS_ARRAY_SORT_MACROS_H
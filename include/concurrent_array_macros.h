@@ -0,0 +1,374 @@
+/*
+ * array-macros
+ * Copyright (C) 2025  Thomas George Hodgkinson
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARRAY_MACROS_CONCURRENT_ARRAY_MACROS_H
+#define ARRAY_MACROS_CONCURRENT_ARRAY_MACROS_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h> // for size_t
+#include <stdint.h> // for SIZE_MAX
+#include <string.h>
+
+#include "array_macros.h"
+#include "segmented_array_macros.h"
+
+/*
+ * An append-only array for many producer threads. It uses the segmented
+ * chunk layout, so storage never moves and readers never wait on growth.
+ *
+ * A producer reserves a slot with an atomic fetch-add on `reserved`,
+ * writes its element and marks the slot ready. It then advances
+ * `published` across every consecutive ready slot, so whichever producer
+ * fills a gap publishes the slots behind it and no producer waits on
+ * another. Readers only see indices below `published`, so they always
+ * observe a fully written prefix. A push becomes visible once every
+ * earlier push has completed.
+ *
+ * If a chunk allocation fails, publication stops at that slot: the
+ * published prefix stays readable and every later push returns false.
+ *
+ * Pushes and reads may run concurrently from any thread. create and free
+ * must not overlap with other calls. A custom allocator must be
+ * thread-safe.
+ */
+
+#define DECLARE_CONCURRENT_ARRAY_STRUCT(prefix, name) \
+    typedef struct prefix##_concurrent_array name##ConcurrentArray;
+
+#define DECLARE_CONCURRENT_ARRAY_FUNCTIONS(prefix, name, type)              \
+    name##ConcurrentArray *prefix##_concurrent_array_create(                \
+        size_t initial_capacity);                                           \
+    name##ConcurrentArray *prefix##_concurrent_array_create_with_allocator( \
+        size_t initial_capacity, const ArrayAllocator *allocator);          \
+    void prefix##_concurrent_array_free(                                    \
+        name##ConcurrentArray *prefix##_concurrent_array);                  \
+                                                                            \
+    size_t prefix##_concurrent_array_get_count(                             \
+        const name##ConcurrentArray *prefix##_concurrent_array);            \
+                                                                            \
+    bool prefix##_concurrent_array_push(                                    \
+        name##ConcurrentArray *prefix##_concurrent_array, type item);       \
+    bool prefix##_concurrent_array_get(                                     \
+        const name##ConcurrentArray *prefix##_concurrent_array,             \
+        size_t index,                                                       \
+        type *out_item);                                                    \
+    const type *prefix##_concurrent_array_get_ptr(                          \
+        const name##ConcurrentArray *prefix##_concurrent_array, size_t index);
+
+#define DEFINE_CONCURRENT_ARRAY_STRUCT(prefix, name, type)  \
+    typedef struct prefix##_concurrent_array                \
+    {                                                       \
+        _Atomic(type *) chunks[SEGMENTED_ARRAY_MAX_CHUNKS]; \
+        size_t base_shift;                                  \
+        atomic_size_t reserved;                             \
+        atomic_size_t published;                            \
+        atomic_size_t failed_index;                         \
+        const ArrayAllocator *allocator;                    \
+    } name##ConcurrentArray;
+
+#define DEFINE_CONCURRENT_ARRAY_FUNCTIONS(prefix, name, type)                       \
+    static inline type *prefix##_concurrent_array_add_chunk_impl(                   \
+        name##ConcurrentArray *prefix##_concurrent_array, size_t chunk);            \
+                                                                                    \
+    static inline size_t prefix##_concurrent_array_chunk_impl(                      \
+        const name##ConcurrentArray *prefix##_concurrent_array, size_t index)       \
+    {                                                                               \
+        return segmented_array_floor_log2_impl(                                     \
+            (index >> prefix##_concurrent_array->base_shift) + 1);                  \
+    }                                                                               \
+                                                                                    \
+    static inline size_t prefix##_concurrent_array_offset_impl(                     \
+        const name##ConcurrentArray *prefix##_concurrent_array,                     \
+        size_t index,                                                               \
+        size_t chunk)                                                               \
+    {                                                                               \
+        const size_t shift = prefix##_concurrent_array->base_shift;                 \
+        return index + ((size_t)1 << shift) - ((size_t)1 << (shift + chunk));       \
+    }                                                                               \
+                                                                                    \
+    /* Each chunk stores its elements followed by one ready flag per slot. */       \
+    static inline atomic_uchar *prefix##_concurrent_array_ready_impl(               \
+        const name##ConcurrentArray *prefix##_concurrent_array,                     \
+        type *data,                                                                 \
+        size_t chunk)                                                               \
+    {                                                                               \
+        const size_t chunk_capacity =                                               \
+            (size_t)1 << (prefix##_concurrent_array->base_shift + chunk);           \
+        return (atomic_uchar *)(void *)(data + chunk_capacity);                     \
+    }                                                                               \
+                                                                                    \
+    static inline void prefix##_concurrent_array_publish_impl(                      \
+        name##ConcurrentArray *prefix##_concurrent_array)                           \
+    {                                                                               \
+        size_t published = atomic_load(&prefix##_concurrent_array->published);      \
+                                                                                    \
+        for (;;)                                                                    \
+        {                                                                           \
+            const size_t chunk = prefix##_concurrent_array_chunk_impl(              \
+                prefix##_concurrent_array, published);                              \
+            type *data = atomic_load(&prefix##_concurrent_array->chunks[chunk]);    \
+                                                                                    \
+            if (!data)                                                              \
+                return;                                                             \
+                                                                                    \
+            const size_t offset = prefix##_concurrent_array_offset_impl(            \
+                prefix##_concurrent_array, published, chunk);                       \
+            if (!atomic_load(&prefix##_concurrent_array_ready_impl(                 \
+                    prefix##_concurrent_array, data, chunk)[offset]))               \
+                return;                                                             \
+                                                                                    \
+            /* On failure published is reloaded, so retry from there. */            \
+            if (atomic_compare_exchange_strong(                                     \
+                    &prefix##_concurrent_array->published,                          \
+                    &published,                                                     \
+                    published + 1))                                                 \
+                published++;                                                        \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    static inline void prefix##_concurrent_array_fail_impl(                         \
+        name##ConcurrentArray *prefix##_concurrent_array, size_t index)             \
+    {                                                                               \
+        size_t failed_index = atomic_load_explicit(                                 \
+            &prefix##_concurrent_array->failed_index, memory_order_relaxed);        \
+                                                                                    \
+        while (index < failed_index)                                                \
+        {                                                                           \
+            if (atomic_compare_exchange_weak_explicit(                              \
+                    &prefix##_concurrent_array->failed_index,                       \
+                    &failed_index,                                                  \
+                    index,                                                          \
+                    memory_order_relaxed,                                           \
+                    memory_order_relaxed))                                          \
+                break;                                                              \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    name##ConcurrentArray *prefix##_concurrent_array_create_with_allocator(         \
+        size_t initial_capacity, const ArrayAllocator *allocator)                   \
+    {                                                                               \
+        if (!initial_capacity)                                                      \
+        {                                                                           \
+            ARRAY_MACROS_REPORT(                                                    \
+                "%s: Initial capacity cannot be 0\n",                               \
+                __func__);                                                          \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        size_t base_shift = segmented_array_floor_log2_impl(initial_capacity);      \
+        if (initial_capacity & (initial_capacity - 1))                              \
+            base_shift++;                                                           \
+                                                                                    \
+        if (base_shift >= SEGMENTED_ARRAY_MAX_CHUNKS                                \
+            || ((size_t)1 << base_shift) > SIZE_MAX / (sizeof(type) + 1))           \
+        {                                                                           \
+            ARRAY_MACROS_REPORT(                                                    \
+                "%s: Initial capacity (%zu) is too large\n",                        \
+                __func__,                                                           \
+                initial_capacity);                                                  \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        name##ConcurrentArray *prefix##_concurrent_array =                          \
+            array_allocator_allocate_impl(                                          \
+                allocator, sizeof(*prefix##_concurrent_array));                     \
+        if (!prefix##_concurrent_array)                                             \
+        {                                                                           \
+            ARRAY_MACROS_REPORT_ERRNO(                                              \
+                #prefix "_concurrent_array allocation failure");                    \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        for (size_t i = 0; i < SEGMENTED_ARRAY_MAX_CHUNKS; i++)                     \
+            atomic_init(&prefix##_concurrent_array->chunks[i], NULL);               \
+        prefix##_concurrent_array->base_shift = base_shift;                         \
+        atomic_init(&prefix##_concurrent_array->reserved, 0);                       \
+        atomic_init(&prefix##_concurrent_array->published, 0);                      \
+        atomic_init(&prefix##_concurrent_array->failed_index, SIZE_MAX);            \
+        prefix##_concurrent_array->allocator = allocator;                           \
+                                                                                    \
+        if (!prefix##_concurrent_array_add_chunk_impl(                              \
+                prefix##_concurrent_array, 0))                                      \
+        {                                                                           \
+            array_allocator_deallocate_impl(                                        \
+                allocator, prefix##_concurrent_array);                              \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        return prefix##_concurrent_array;                                           \
+    }                                                                               \
+                                                                                    \
+    name##ConcurrentArray *prefix##_concurrent_array_create(                        \
+        size_t initial_capacity)                                                    \
+    {                                                                               \
+        return prefix##_concurrent_array_create_with_allocator(                     \
+            initial_capacity, NULL);                                                \
+    }                                                                               \
+                                                                                    \
+    void prefix##_concurrent_array_free(                                            \
+        name##ConcurrentArray *prefix##_concurrent_array)                           \
+    {                                                                               \
+        const ArrayAllocator *allocator =                                           \
+            prefix##_concurrent_array->allocator;                                   \
+                                                                                    \
+        for (size_t i = 0; i < SEGMENTED_ARRAY_MAX_CHUNKS; i++)                     \
+            array_allocator_deallocate_impl(                                        \
+                allocator,                                                          \
+                atomic_load_explicit(                                               \
+                    &prefix##_concurrent_array->chunks[i],                          \
+                    memory_order_relaxed));                                         \
+        array_allocator_deallocate_impl(allocator, prefix##_concurrent_array);      \
+    }                                                                               \
+                                                                                    \
+    size_t prefix##_concurrent_array_get_count(                                     \
+        const name##ConcurrentArray *prefix##_concurrent_array)                     \
+    {                                                                               \
+        return atomic_load_explicit(                                                \
+            &prefix##_concurrent_array->published, memory_order_acquire);           \
+    }                                                                               \
+                                                                                    \
+    bool prefix##_concurrent_array_push(                                            \
+        name##ConcurrentArray *prefix##_concurrent_array, type item)                \
+    {                                                                               \
+        if (atomic_load_explicit(                                                   \
+                &prefix##_concurrent_array->failed_index, memory_order_relaxed)     \
+            != SIZE_MAX)                                                            \
+            return false;                                                           \
+                                                                                    \
+        const size_t index = atomic_fetch_add_explicit(                             \
+            &prefix##_concurrent_array->reserved, 1, memory_order_relaxed);         \
+        const size_t chunk =                                                        \
+            prefix##_concurrent_array_chunk_impl(prefix##_concurrent_array, index); \
+        type *data = atomic_load_explicit(                                          \
+            &prefix##_concurrent_array->chunks[chunk], memory_order_acquire);       \
+                                                                                    \
+        if (!data)                                                                  \
+            data = prefix##_concurrent_array_add_chunk_impl(                        \
+                prefix##_concurrent_array, chunk);                                  \
+                                                                                    \
+        if (!data)                                                                  \
+        {                                                                           \
+            prefix##_concurrent_array_fail_impl(prefix##_concurrent_array, index);  \
+            return false;                                                           \
+        }                                                                           \
+                                                                                    \
+        const size_t offset = prefix##_concurrent_array_offset_impl(                \
+            prefix##_concurrent_array, index, chunk);                               \
+        data[offset] = item;                                                        \
+        atomic_store(                                                               \
+            &prefix##_concurrent_array_ready_impl(                                  \
+                prefix##_concurrent_array, data, chunk)[offset],                    \
+            1);                                                                     \
+                                                                                    \
+        prefix##_concurrent_array_publish_impl(prefix##_concurrent_array);          \
+                                                                                    \
+        return atomic_load_explicit(                                                \
+                   &prefix##_concurrent_array->failed_index,                        \
+                   memory_order_relaxed)                                            \
+            > index;                                                                \
+    }                                                                               \
+                                                                                    \
+    bool prefix##_concurrent_array_get(                                             \
+        const name##ConcurrentArray *prefix##_concurrent_array,                     \
+        size_t index,                                                               \
+        type *out_item)                                                             \
+    {                                                                               \
+        const type *item = prefix##_concurrent_array_get_ptr(                       \
+            prefix##_concurrent_array, index);                                      \
+                                                                                    \
+        if (!item)                                                                  \
+        {                                                                           \
+            ARRAY_MACROS_REPORT(                                                    \
+                "%s: Index (%zu) out of bounds\n",                                  \
+                __func__,                                                           \
+                index);                                                             \
+            return false;                                                           \
+        }                                                                           \
+                                                                                    \
+        *out_item = *item;                                                          \
+                                                                                    \
+        return true;                                                                \
+    }                                                                               \
+                                                                                    \
+    const type *prefix##_concurrent_array_get_ptr(                                  \
+        const name##ConcurrentArray *prefix##_concurrent_array, size_t index)       \
+    {                                                                               \
+        if (index >= prefix##_concurrent_array_get_count(                           \
+                prefix##_concurrent_array))                                         \
+            return NULL;                                                            \
+                                                                                    \
+        const size_t chunk =                                                        \
+            prefix##_concurrent_array_chunk_impl(prefix##_concurrent_array, index); \
+        const type *data = atomic_load_explicit(                                    \
+            &prefix##_concurrent_array->chunks[chunk], memory_order_acquire);       \
+                                                                                    \
+        return &data[prefix##_concurrent_array_offset_impl(                         \
+            prefix##_concurrent_array, index, chunk)];                              \
+    }                                                                               \
+                                                                                    \
+    static inline type *prefix##_concurrent_array_add_chunk_impl(                   \
+        name##ConcurrentArray *prefix##_concurrent_array, size_t chunk)             \
+    {                                                                               \
+        const size_t shift = prefix##_concurrent_array->base_shift + chunk;         \
+                                                                                    \
+        if (shift >= SEGMENTED_ARRAY_MAX_CHUNKS - 1                                 \
+            || ((size_t)1 << shift) > SIZE_MAX / (sizeof(type) + 1))                \
+        {                                                                           \
+            ARRAY_MACROS_REPORT(                                                    \
+                "%s: Chunk %zu would overflow\n",                                   \
+                __func__,                                                           \
+                chunk);                                                             \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        const size_t chunk_capacity = (size_t)1 << shift;                           \
+        type *data = array_allocator_allocate_impl(                                 \
+            prefix##_concurrent_array->allocator,                                   \
+            chunk_capacity * (sizeof(type) + 1));                                   \
+        if (!data)                                                                  \
+        {                                                                           \
+            ARRAY_MACROS_REPORT_ERRNO(                                              \
+                #prefix "_concurrent_array_add_chunk_impl: Error with allocation"); \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        memset(                                                                     \
+            prefix##_concurrent_array_ready_impl(                                   \
+                prefix##_concurrent_array, data, chunk),                            \
+            0,                                                                      \
+            chunk_capacity);                                                        \
+                                                                                    \
+        /* Several producers may race to add the same chunk; one wins. */           \
+        type *expected = NULL;                                                      \
+        if (!atomic_compare_exchange_strong_explicit(                               \
+                &prefix##_concurrent_array->chunks[chunk],                          \
+                &expected,                                                          \
+                data,                                                               \
+                memory_order_acq_rel,                                               \
+                memory_order_acquire))                                              \
+        {                                                                           \
+            array_allocator_deallocate_impl(                                        \
+                prefix##_concurrent_array->allocator, data);                        \
+            return expected;                                                        \
+        }                                                                           \
+                                                                                    \
+        return data;                                                                \
+    }
+
+#endif // ARRAY_MACROS_CONCURRENT_ARRAY_MACROS_H
@@ -0,0 +1,379 @@
+/*
+ * array-macros
+ * Copyright (C) 2025  Thomas George Hodgkinson
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARRAY_MACROS_DEQUE_MACROS_H
+#define ARRAY_MACROS_DEQUE_MACROS_H
+
+#include <stdbool.h>
+#include <stddef.h> // for size_t
+#include <stdint.h> // for SIZE_MAX
+#include <string.h>
+
+#include "array_macros.h"
+
+/*
+ * A circular buffer with amortised O(1) push and pop at both ends. The
+ * elements occupy capacity slots starting at head and wrap around to the
+ * start of the buffer.
+ */
+
+#define DECLARE_DEQUE_STRUCT(prefix, name) \
+    typedef struct prefix##_deque name##Deque;
+
+#define DECLARE_DEQUE_FUNCTIONS(prefix, name, type)                                \
+    name##Deque *prefix##_deque_create(size_t initial_capacity);                   \
+    name##Deque *prefix##_deque_create_with_allocator(                             \
+        size_t initial_capacity, const ArrayAllocator *allocator);                 \
+    void prefix##_deque_free(name##Deque *prefix##_deque);                         \
+                                                                                   \
+    size_t prefix##_deque_get_count(const name##Deque *prefix##_deque);            \
+    size_t prefix##_deque_get_capacity(const name##Deque *prefix##_deque);         \
+    ArrayErrorType prefix##_deque_get_last_error(                                  \
+        const name##Deque *prefix##_deque);                                        \
+    void prefix##_deque_get_stats(                                                 \
+        const name##Deque *prefix##_deque, ArrayStats *out_stats);                 \
+                                                                                   \
+    bool prefix##_deque_push_back(name##Deque *prefix##_deque, type item);         \
+    bool prefix##_deque_push_front(name##Deque *prefix##_deque, type item);        \
+    bool prefix##_deque_pop_back(name##Deque *prefix##_deque, type *out_item);     \
+    bool prefix##_deque_pop_front(name##Deque *prefix##_deque, type *out_item);    \
+    bool prefix##_deque_set(name##Deque *prefix##_deque, size_t index, type item); \
+    bool prefix##_deque_get(                                                       \
+        name##Deque *prefix##_deque, size_t index, type *out_item);                \
+    bool prefix##_deque_is_empty(const name##Deque *prefix##_deque);               \
+    bool prefix##_deque_is_full(const name##Deque *prefix##_deque);                \
+    void prefix##_deque_clear(name##Deque *prefix##_deque);                        \
+    bool prefix##_deque_reserve(name##Deque *prefix##_deque, size_t capacity);
+
+#define DEFINE_DEQUE_STRUCT(prefix, name, type) \
+    typedef struct prefix##_deque               \
+    {                                           \
+        type *data;                             \
+        size_t head;                            \
+        size_t count;                           \
+        size_t capacity;                        \
+        ArrayErrorType last_error;              \
+        const ArrayAllocator *allocator;        \
+        ARRAY_STATS_FIELD_IMPL                  \
+    } name##Deque;
+
+#define DEFINE_DEQUE_FUNCTIONS(prefix, name, type)                                 \
+    static inline bool prefix##_deque_grow_impl(name##Deque *prefix##_deque);      \
+    static inline bool prefix##_deque_resize_impl(                                 \
+        name##Deque *prefix##_deque, size_t new_capacity);                         \
+                                                                                   \
+    static inline size_t prefix##_deque_slot_impl(                                 \
+        const name##Deque *prefix##_deque, size_t index)                           \
+    {                                                                              \
+        const size_t slot = prefix##_deque->head + index;                          \
+        return slot >= prefix##_deque->capacity                                    \
+            ? slot - prefix##_deque->capacity                                      \
+            : slot;                                                                \
+    }                                                                              \
+                                                                                   \
+    name##Deque *prefix##_deque_create_with_allocator(                             \
+        size_t initial_capacity, const ArrayAllocator *allocator)                  \
+    {                                                                              \
+        if (!initial_capacity)                                                     \
+        {                                                                          \
+            ARRAY_MACROS_REPORT(                                                   \
+                "%s: Initial capacity cannot be 0\n",                              \
+                __func__);                                                         \
+            return NULL;                                                           \
+        }                                                                          \
+                                                                                   \
+        if (initial_capacity > SIZE_MAX / 2 / sizeof(type))                        \
+        {                                                                          \
+            ARRAY_MACROS_REPORT(                                                   \
+                "%s: Initial capacity cannot be greater than %zu\n",               \
+                __func__,                                                          \
+                SIZE_MAX / 2 / sizeof(type));                                      \
+            return NULL;                                                           \
+        }                                                                          \
+                                                                                   \
+        name##Deque *prefix##_deque =                                              \
+            array_allocator_allocate_impl(allocator, sizeof(*prefix##_deque));     \
+        if (!prefix##_deque)                                                       \
+        {                                                                          \
+            ARRAY_MACROS_REPORT_ERRNO(#prefix "_deque allocation failure");        \
+            return NULL;                                                           \
+        }                                                                          \
+                                                                                   \
+        prefix##_deque->head = 0;                                                  \
+        prefix##_deque->count = 0;                                                 \
+        prefix##_deque->capacity = initial_capacity;                               \
+        prefix##_deque->last_error = ARRAY_ERROR_TYPE_NONE;                        \
+        prefix##_deque->allocator = allocator;                                     \
+        ARRAY_STATS_INIT_IMPL(prefix##_deque);                                     \
+        prefix##_deque->data = array_allocator_allocate_impl(                      \
+            allocator,                                                             \
+            prefix##_deque->capacity * sizeof(*prefix##_deque->data));             \
+        if (!prefix##_deque->data)                                                 \
+        {                                                                          \
+            ARRAY_MACROS_REPORT_ERRNO(#prefix "_deque data allocation failure");   \
+            array_allocator_deallocate_impl(allocator, prefix##_deque);            \
+            return NULL;                                                           \
+        }                                                                          \
+                                                                                   \
+        return prefix##_deque;                                                     \
+    }                                                                              \
+                                                                                   \
+    name##Deque *prefix##_deque_create(size_t initial_capacity)                    \
+    {                                                                              \
+        return prefix##_deque_create_with_allocator(initial_capacity, NULL);       \
+    }                                                                              \
+                                                                                   \
+    void prefix##_deque_free(name##Deque *prefix##_deque)                          \
+    {                                                                              \
+        const ArrayAllocator *allocator = prefix##_deque->allocator;               \
+                                                                                   \
+        array_allocator_deallocate_impl(allocator, prefix##_deque->data);          \
+        array_allocator_deallocate_impl(allocator, prefix##_deque);                \
+    }                                                                              \
+                                                                                   \
+    size_t prefix##_deque_get_count(const name##Deque *prefix##_deque)             \
+    {                                                                              \
+        return prefix##_deque->count;                                              \
+    }                                                                              \
+                                                                                   \
+    size_t prefix##_deque_get_capacity(const name##Deque *prefix##_deque)          \
+    {                                                                              \
+        return prefix##_deque->capacity;                                           \
+    }                                                                              \
+                                                                                   \
+    ArrayErrorType prefix##_deque_get_last_error(                                  \
+        const name##Deque *prefix##_deque)                                         \
+    {                                                                              \
+        return prefix##_deque->last_error;                                         \
+    }                                                                              \
+                                                                                   \
+    void prefix##_deque_get_stats(                                                 \
+        const name##Deque *prefix##_deque, ArrayStats *out_stats)                  \
+    {                                                                              \
+        *out_stats = ARRAY_STATS_GET_IMPL(prefix##_deque);                         \
+    }                                                                              \
+                                                                                   \
+    bool prefix##_deque_push_back(name##Deque *prefix##_deque, type item)          \
+    {                                                                              \
+        if (!prefix##_deque_grow_impl(prefix##_deque))                             \
+            return false;                                                          \
+                                                                                   \
+        const size_t slot =                                                        \
+            prefix##_deque_slot_impl(prefix##_deque, prefix##_deque->count);       \
+        prefix##_deque->data[slot] = item;                                         \
+        prefix##_deque->count++;                                                   \
+                                                                                   \
+        return true;                                                               \
+    }                                                                              \
+                                                                                   \
+    bool prefix##_deque_push_front(name##Deque *prefix##_deque, type item)         \
+    {                                                                              \
+        if (!prefix##_deque_grow_impl(prefix##_deque))                             \
+            return false;                                                          \
+                                                                                   \
+        prefix##_deque->head = prefix##_deque->head                                \
+            ? prefix##_deque->head - 1                                             \
+            : prefix##_deque->capacity - 1;                                        \
+        prefix##_deque->data[prefix##_deque->head] = item;                         \
+        prefix##_deque->count++;                                                   \
+                                                                                   \
+        return true;                                                               \
+    }                                                                              \
+                                                                                   \
+    bool prefix##_deque_pop_back(name##Deque *prefix##_deque, type *out_item)      \
+    {                                                                              \
+        if (prefix##_deque->count == 0)                                            \
+        {                                                                          \
+            ARRAY_SET_ERROR_IMPL(prefix##_deque, ARRAY_ERROR_TYPE_EMPTY);          \
+            ARRAY_MACROS_REPORT("%s: Deque is empty (count 0)\n", __func__);       \
+            return false;                                                          \
+        }                                                                          \
+                                                                                   \
+        prefix##_deque->count--;                                                   \
+                                                                                   \
+        if (out_item)                                                              \
+        {                                                                          \
+            const size_t slot =                                                    \
+                prefix##_deque_slot_impl(prefix##_deque, prefix##_deque->count);   \
+            *out_item = prefix##_deque->data[slot];                                \
+        }                                                                          \
+                                                                                   \
+        return true;                                                               \
+    }                                                                              \
+                                                                                   \
+    bool prefix##_deque_pop_front(name##Deque *prefix##_deque, type *out_item)     \
+    {                                                                              \
+        if (prefix##_deque->count == 0)                                            \
+        {                                                                          \
+            ARRAY_SET_ERROR_IMPL(prefix##_deque, ARRAY_ERROR_TYPE_EMPTY);          \
+            ARRAY_MACROS_REPORT("%s: Deque is empty (count 0)\n", __func__);       \
+            return false;                                                          \
+        }                                                                          \
+                                                                                   \
+        if (out_item)                                                              \
+            *out_item = prefix##_deque->data[prefix##_deque->head];                \
+                                                                                   \
+        prefix##_deque->head =                                                     \
+            prefix##_deque_slot_impl(prefix##_deque, 1);                           \
+        prefix##_deque->count--;                                                   \
+                                                                                   \
+        return true;                                                               \
+    }                                                                              \
+                                                                                   \
+    bool prefix##_deque_set(name##Deque *prefix##_deque, size_t index, type item)  \
+    {                                                                              \
+        if (prefix##_deque->count == 0)                                            \
+        {                                                                          \
+            ARRAY_SET_ERROR_IMPL(prefix##_deque, ARRAY_ERROR_TYPE_EMPTY);          \
+            ARRAY_MACROS_REPORT("%s: Deque is empty (count 0)\n", __func__);       \
+            return false;                                                          \
+        }                                                                          \
+                                                                                   \
+        if (index >= prefix##_deque->count)                                        \
+        {                                                                          \
+            ARRAY_SET_ERROR_IMPL(prefix##_deque, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);  \
+            ARRAY_MACROS_REPORT(                                                   \
+                "%s: Index (%zu) out of bounds (%zu)\n",                           \
+                __func__,                                                          \
+                index,                                                             \
+                prefix##_deque->count);                                            \
+            return false;                                                          \
+        }                                                                          \
+                                                                                   \
+        prefix##_deque->data[prefix##_deque_slot_impl(prefix##_deque, index)] =    \
+            item;                                                                  \
+                                                                                   \
+        return true;                                                               \
+    }                                                                              \
+                                                                                   \
+    bool prefix##_deque_get(                                                       \
+        name##Deque *prefix##_deque, size_t index, type *out_item)                 \
+    {                                                                              \
+        if (prefix##_deque->count == 0)                                            \
+        {                                                                          \
+            ARRAY_SET_ERROR_IMPL(prefix##_deque, ARRAY_ERROR_TYPE_EMPTY);          \
+            ARRAY_MACROS_REPORT("%s: Deque is empty (count 0)\n", __func__);       \
+            return false;                                                          \
+        }                                                                          \
+                                                                                   \
+        if (index >= prefix##_deque->count)                                        \
+        {                                                                          \
+            ARRAY_SET_ERROR_IMPL(prefix##_deque, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);  \
+            ARRAY_MACROS_REPORT(                                                   \
+                "%s: Index (%zu) out of bounds (%zu)\n",                           \
+                __func__,                                                          \
+                index,                                                             \
+                prefix##_deque->count);                                            \
+            return false;                                                          \
+        }                                                                          \
+                                                                                   \
+        *out_item =                                                                \
+            prefix##_deque->data[prefix##_deque_slot_impl(prefix##_deque, index)]; \
+                                                                                   \
+        return true;                                                               \
+    }                                                                              \
+                                                                                   \
+    bool prefix##_deque_is_empty(const name##Deque *prefix##_deque)                \
+    {                                                                              \
+        return !prefix##_deque->count;                                             \
+    }                                                                              \
+                                                                                   \
+    bool prefix##_deque_is_full(const name##Deque *prefix##_deque)                 \
+    {                                                                              \
+        return prefix##_deque->count == prefix##_deque->capacity;                  \
+    }                                                                              \
+                                                                                   \
+    void prefix##_deque_clear(name##Deque *prefix##_deque)                         \
+    {                                                                              \
+        prefix##_deque->head = 0;                                                  \
+        prefix##_deque->count = 0;                                                 \
+    }                                                                              \
+                                                                                   \
+    bool prefix##_deque_reserve(name##Deque *prefix##_deque, size_t capacity)      \
+    {                                                                              \
+        if (capacity <= prefix##_deque->capacity)                                  \
+            return true;                                                           \
+                                                                                   \
+        return prefix##_deque_resize_impl(prefix##_deque, capacity);               \
+    }                                                                              \
+                                                                                   \
+    static inline bool prefix##_deque_grow_impl(name##Deque *prefix##_deque)       \
+    {                                                                              \
+        if (prefix##_deque->count < prefix##_deque->capacity)                      \
+            return true;                                                           \
+                                                                                   \
+        return prefix##_deque_resize_impl(                                         \
+            prefix##_deque, prefix##_deque->capacity * 2);                         \
+    }                                                                              \
+                                                                                   \
+    static inline bool prefix##_deque_resize_impl(                                 \
+        name##Deque *prefix##_deque, size_t new_capacity)                          \
+    {                                                                              \
+        if (new_capacity > SIZE_MAX / 2 / sizeof(*prefix##_deque->data))           \
+        {                                                                          \
+            ARRAY_SET_ERROR_IMPL(prefix##_deque, ARRAY_ERROR_TYPE_OVERFLOW);       \
+            ARRAY_MACROS_REPORT(                                                   \
+                "%s: Capacity cannot be greater than %zu\n",                       \
+                __func__,                                                          \
+                SIZE_MAX / 2 / sizeof(*prefix##_deque->data));                     \
+            return false;                                                          \
+        }                                                                          \
+                                                                                   \
+        type *new_data = array_allocator_allocate_impl(                            \
+            prefix##_deque->allocator,                                             \
+            new_capacity * sizeof(*prefix##_deque->data));                         \
+        if (!new_data)                                                             \
+        {                                                                          \
+            ARRAY_SET_ERROR_IMPL(prefix##_deque, ARRAY_ERROR_TYPE_ALLOCATION);     \
+            ARRAY_MACROS_REPORT_ERRNO(                                             \
+                #prefix "_deque_resize_impl: Error with allocation");              \
+            return false;                                                          \
+        }                                                                          \
+                                                                                   \
+        const size_t tail_room =                                                   \
+            prefix##_deque->capacity - prefix##_deque->head;                       \
+        const size_t first = prefix##_deque->count < tail_room                     \
+            ? prefix##_deque->count                                                \
+            : tail_room;                                                           \
+                                                                                   \
+        memcpy(                                                                    \
+            new_data,                                                              \
+            &prefix##_deque->data[prefix##_deque->head],                           \
+            first * sizeof(*prefix##_deque->data));                                \
+        memcpy(                                                                    \
+            &new_data[first],                                                      \
+            prefix##_deque->data,                                                  \
+            (prefix##_deque->count - first) * sizeof(*prefix##_deque->data));      \
+        ARRAY_STATS_ADD_IMPL(                                                      \
+            prefix##_deque,                                                        \
+            bytes_moved,                                                           \
+            prefix##_deque->count * sizeof(*prefix##_deque->data));                \
+                                                                                   \
+        array_allocator_deallocate_impl(                                           \
+            prefix##_deque->allocator, prefix##_deque->data);                      \
+                                                                                   \
+        prefix##_deque->data = new_data;                                           \
+        prefix##_deque->head = 0;                                                  \
+        prefix##_deque->capacity = new_capacity;                                   \
+        ARRAY_STATS_ADD_IMPL(prefix##_deque, reallocs, 1);                         \
+        ARRAY_STATS_PEAK_IMPL(prefix##_deque);                                     \
+                                                                                   \
+        return true;                                                               \
+    }
+
+#endif // ARRAY_MACROS_DEQUE_MACROS_H
@@ -0,0 +1,493 @@
+/*
+ * array-macros
+ * Copyright (C) 2025  Thomas George Hodgkinson
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARRAY_MACROS_MAPPED_ARRAY_MACROS_H
+#define ARRAY_MACROS_MAPPED_ARRAY_MACROS_H
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h> // for size_t
+#include <stdint.h> // for SIZE_MAX
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "array_io_macros.h"
+#include "array_macros.h"
+
+/*
+ * An array whose storage is a memory-mapped file. The file holds an
+ * ArrayFileHeader, whose count is kept current on every change, and the
+ * elements from ARRAY_MAPPED_DATA_OFFSET. Reopening the file maps the
+ * elements back in place without reading them, and pages of a file larger
+ * than memory are only loaded when touched.
+ *
+ * Growing extends the file with ftruncate and remaps it, with mremap where
+ * available (Linux with _GNU_SOURCE) or a fresh mmap otherwise. Either way
+ * pointers into the array are invalidated by growth.
+ *
+ * Changes reach the file through the page cache; sync flushes them to
+ * disk. A file must only be open through one mapped array at a time.
+ * POSIX only: define _POSIX_C_SOURCE or _GNU_SOURCE when compiling with a
+ * strict -std=c17.
+ */
+
+/* Elements start here, so any element alignment up to 64 is honoured. */
+#define ARRAY_MAPPED_DATA_OFFSET ((size_t)64)
+
+static inline void *array_mapped_remap_impl(
+    int fd, void *map, size_t old_size, size_t new_size)
+{
+#if defined(MREMAP_MAYMOVE)
+    (void)fd;
+    return mremap(map, old_size, new_size, MREMAP_MAYMOVE);
+#else
+    /* Map the grown file first, so a failure leaves the old view intact. */
+    void *new_map =
+        mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (new_map != MAP_FAILED)
+        munmap(map, old_size);
+
+    return new_map;
+#endif
+}
+
+#define DECLARE_MAPPED_ARRAY_STRUCT(prefix, name) \
+    typedef struct prefix##_mapped_array name##MappedArray;
+
+#define DECLARE_MAPPED_ARRAY_FUNCTIONS(prefix, name, type)                     \
+    name##MappedArray *prefix##_mapped_array_open(                             \
+        const char *path, size_t initial_capacity);                            \
+    void prefix##_mapped_array_close(                                          \
+        name##MappedArray *prefix##_mapped_array);                             \
+    bool prefix##_mapped_array_sync(name##MappedArray *prefix##_mapped_array); \
+                                                                               \
+    size_t prefix##_mapped_array_get_count(                                    \
+        const name##MappedArray *prefix##_mapped_array);                       \
+    size_t prefix##_mapped_array_get_capacity(                                 \
+        const name##MappedArray *prefix##_mapped_array);                       \
+    const type *prefix##_mapped_array_get_data(                                \
+        const name##MappedArray *prefix##_mapped_array);                       \
+    type *prefix##_mapped_array_get_data_mut(                                  \
+        name##MappedArray *prefix##_mapped_array);                             \
+    ArrayErrorType prefix##_mapped_array_get_last_error(                       \
+        const name##MappedArray *prefix##_mapped_array);                       \
+    void prefix##_mapped_array_get_stats(                                      \
+        const name##MappedArray *prefix##_mapped_array,                        \
+        ArrayStats *out_stats);                                                \
+                                                                               \
+    bool prefix##_mapped_array_push(                                           \
+        name##MappedArray *prefix##_mapped_array, type item);                  \
+    bool prefix##_mapped_array_pop(                                            \
+        name##MappedArray *prefix##_mapped_array, type *out_item);             \
+    bool prefix##_mapped_array_set(                                            \
+        name##MappedArray *prefix##_mapped_array, size_t index, type item);    \
+    bool prefix##_mapped_array_get(                                            \
+        name##MappedArray *prefix##_mapped_array,                              \
+        size_t index,                                                          \
+        type *out_item);                                                       \
+    void prefix##_mapped_array_clear(                                          \
+        name##MappedArray *prefix##_mapped_array);                             \
+    bool prefix##_mapped_array_reserve(                                        \
+        name##MappedArray *prefix##_mapped_array, size_t capacity);
+
+#define DEFINE_MAPPED_ARRAY_STRUCT(prefix, name, type) \
+    typedef struct prefix##_mapped_array               \
+    {                                                  \
+        ArrayFileHeader *header;                       \
+        type *data;                                    \
+        size_t capacity;                               \
+        ArrayErrorType last_error;                     \
+        int fd;                                        \
+        ARRAY_STATS_FIELD_IMPL                         \
+    } name##MappedArray;
+
+#define DEFINE_MAPPED_ARRAY_FUNCTIONS(prefix, name, type)                              \
+    static inline bool prefix##_mapped_array_resize_impl(                              \
+        name##MappedArray *prefix##_mapped_array, size_t new_capacity);                \
+                                                                                       \
+    static inline size_t prefix##_mapped_array_file_size_impl(size_t capacity)         \
+    {                                                                                  \
+        return ARRAY_MAPPED_DATA_OFFSET + capacity * sizeof(type);                     \
+    }                                                                                  \
+                                                                                       \
+    static inline bool prefix##_mapped_array_fits_impl(size_t capacity)                \
+    {                                                                                  \
+        return capacity <= (SIZE_MAX - ARRAY_MAPPED_DATA_OFFSET) / sizeof(type);       \
+    }                                                                                  \
+                                                                                       \
+    static inline void prefix##_mapped_array_attach_impl(                              \
+        name##MappedArray *prefix##_mapped_array,                                      \
+        void *map,                                                                     \
+        size_t capacity)                                                               \
+    {                                                                                  \
+        prefix##_mapped_array->header = map;                                           \
+        prefix##_mapped_array->data =                                                  \
+            (type *)(void *)((unsigned char *)map + ARRAY_MAPPED_DATA_OFFSET);         \
+        prefix##_mapped_array->capacity = capacity;                                    \
+    }                                                                                  \
+                                                                                       \
+    name##MappedArray *prefix##_mapped_array_open(                                     \
+        const char *path, size_t initial_capacity)                                     \
+    {                                                                                  \
+        if (!initial_capacity)                                                         \
+        {                                                                              \
+            ARRAY_MACROS_REPORT(                                                       \
+                "%s: Initial capacity cannot be 0\n",                                  \
+                __func__);                                                             \
+            return NULL;                                                               \
+        }                                                                              \
+                                                                                       \
+        if (!prefix##_mapped_array_fits_impl(initial_capacity))                        \
+        {                                                                              \
+            ARRAY_MACROS_REPORT(                                                       \
+                "%s: Initial capacity (%zu) is too large\n",                           \
+                __func__,                                                              \
+                initial_capacity);                                                     \
+            return NULL;                                                               \
+        }                                                                              \
+                                                                                       \
+        name##MappedArray *prefix##_mapped_array =                                     \
+            malloc(sizeof(*prefix##_mapped_array));                                    \
+        if (!prefix##_mapped_array)                                                    \
+        {                                                                              \
+            ARRAY_MACROS_REPORT_ERRNO(#prefix "_mapped_array allocation failure");     \
+            return NULL;                                                               \
+        }                                                                              \
+                                                                                       \
+        prefix##_mapped_array->last_error = ARRAY_ERROR_TYPE_NONE;                     \
+        prefix##_mapped_array->fd = open(path, O_RDWR | O_CREAT, 0644);                \
+                                                                                       \
+        struct stat st;                                                                \
+        if (prefix##_mapped_array->fd < 0                                              \
+            || fstat(prefix##_mapped_array->fd, &st))                                  \
+        {                                                                              \
+            ARRAY_MACROS_REPORT_ERRNO(path);                                           \
+            if (prefix##_mapped_array->fd >= 0)                                        \
+                close(prefix##_mapped_array->fd);                                      \
+            free(prefix##_mapped_array);                                               \
+            return NULL;                                                               \
+        }                                                                              \
+                                                                                       \
+        const bool is_new = st.st_size == 0;                                           \
+        size_t capacity = initial_capacity;                                            \
+                                                                                       \
+        if (!is_new)                                                                   \
+        {                                                                              \
+            if ((uintmax_t)st.st_size > SIZE_MAX                                       \
+                || (size_t)st.st_size < ARRAY_MAPPED_DATA_OFFSET)                      \
+            {                                                                          \
+                ARRAY_MACROS_REPORT(                                                   \
+                    "%s: %s is not a mapped array file\n",                             \
+                    __func__,                                                          \
+                    path);                                                             \
+                close(prefix##_mapped_array->fd);                                      \
+                free(prefix##_mapped_array);                                           \
+                return NULL;                                                           \
+            }                                                                          \
+                                                                                       \
+            capacity = ((size_t)st.st_size - ARRAY_MAPPED_DATA_OFFSET)                 \
+                / sizeof(type);                                                        \
+        }                                                                              \
+        else if (ftruncate(                                                            \
+                     prefix##_mapped_array->fd,                                        \
+                     (off_t)prefix##_mapped_array_file_size_impl(capacity)))           \
+        {                                                                              \
+            ARRAY_MACROS_REPORT_ERRNO(path);                                           \
+            close(prefix##_mapped_array->fd);                                          \
+            free(prefix##_mapped_array);                                               \
+            return NULL;                                                               \
+        }                                                                              \
+                                                                                       \
+        const size_t map_size = prefix##_mapped_array_file_size_impl(capacity);        \
+        void *map = mmap(                                                              \
+            NULL,                                                                      \
+            map_size,                                                                  \
+            PROT_READ | PROT_WRITE,                                                    \
+            MAP_SHARED,                                                                \
+            prefix##_mapped_array->fd,                                                 \
+            0);                                                                        \
+        if (map == MAP_FAILED)                                                         \
+        {                                                                              \
+            ARRAY_MACROS_REPORT_ERRNO(path);                                           \
+            close(prefix##_mapped_array->fd);                                          \
+            free(prefix##_mapped_array);                                               \
+            return NULL;                                                               \
+        }                                                                              \
+                                                                                       \
+        prefix##_mapped_array_attach_impl(prefix##_mapped_array, map, capacity);       \
+        ARRAY_STATS_INIT_IMPL(prefix##_mapped_array);                                  \
+                                                                                       \
+        if (is_new)                                                                    \
+        {                                                                              \
+            array_file_header_init_impl(                                               \
+                prefix##_mapped_array->header,                                         \
+                sizeof(type),                                                          \
+                0,                                                                     \
+                ARRAY_MAPPED_DATA_OFFSET);                                             \
+        }                                                                              \
+        else if (!array_file_header_check_impl(                                        \
+                     prefix##_mapped_array->header, sizeof(type))                      \
+            || prefix##_mapped_array->header->data_offset                              \
+                != ARRAY_MAPPED_DATA_OFFSET                                            \
+            || prefix##_mapped_array->header->count > capacity)                        \
+        {                                                                              \
+            ARRAY_MACROS_REPORT(                                                       \
+                "%s: %s is not a valid mapped array file\n",                           \
+                __func__,                                                              \
+                path);                                                                 \
+            munmap(map, map_size);                                                     \
+            close(prefix##_mapped_array->fd);                                          \
+            free(prefix##_mapped_array);                                               \
+            return NULL;                                                               \
+        }                                                                              \
+                                                                                       \
+        return prefix##_mapped_array;                                                  \
+    }                                                                                  \
+                                                                                       \
+    void prefix##_mapped_array_close(name##MappedArray *prefix##_mapped_array)         \
+    {                                                                                  \
+        munmap(                                                                        \
+            prefix##_mapped_array->header,                                             \
+            prefix##_mapped_array_file_size_impl(                                      \
+                prefix##_mapped_array->capacity));                                     \
+        close(prefix##_mapped_array->fd);                                              \
+        free(prefix##_mapped_array);                                                   \
+    }                                                                                  \
+                                                                                       \
+    bool prefix##_mapped_array_sync(name##MappedArray *prefix##_mapped_array)          \
+    {                                                                                  \
+        if (msync(                                                                     \
+                prefix##_mapped_array->header,                                         \
+                prefix##_mapped_array_file_size_impl(                                  \
+                    prefix##_mapped_array->capacity),                                  \
+                MS_SYNC))                                                              \
+        {                                                                              \
+            ARRAY_SET_ERROR_IMPL(prefix##_mapped_array, ARRAY_ERROR_TYPE_IO);          \
+            ARRAY_MACROS_REPORT_ERRNO(#prefix "_mapped_array_sync: Error with msync"); \
+            return false;                                                              \
+        }                                                                              \
+                                                                                       \
+        return true;                                                                   \
+    }                                                                                  \
+                                                                                       \
+    size_t prefix##_mapped_array_get_count(                                            \
+        const name##MappedArray *prefix##_mapped_array)                                \
+    {                                                                                  \
+        return (size_t)prefix##_mapped_array->header->count;                           \
+    }                                                                                  \
+                                                                                       \
+    size_t prefix##_mapped_array_get_capacity(                                         \
+        const name##MappedArray *prefix##_mapped_array)                                \
+    {                                                                                  \
+        return prefix##_mapped_array->capacity;                                        \
+    }                                                                                  \
+                                                                                       \
+    const type *prefix##_mapped_array_get_data(                                        \
+        const name##MappedArray *prefix##_mapped_array)                                \
+    {                                                                                  \
+        return prefix##_mapped_array->data;                                            \
+    }                                                                                  \
+                                                                                       \
+    type *prefix##_mapped_array_get_data_mut(                                          \
+        name##MappedArray *prefix##_mapped_array)                                      \
+    {                                                                                  \
+        return prefix##_mapped_array->data;                                            \
+    }                                                                                  \
+                                                                                       \
+    ArrayErrorType prefix##_mapped_array_get_last_error(                               \
+        const name##MappedArray *prefix##_mapped_array)                                \
+    {                                                                                  \
+        return prefix##_mapped_array->last_error;                                      \
+    }                                                                                  \
+                                                                                       \
+    void prefix##_mapped_array_get_stats(                                              \
+        const name##MappedArray *prefix##_mapped_array,                                \
+        ArrayStats *out_stats)                                                         \
+    {                                                                                  \
+        *out_stats = ARRAY_STATS_GET_IMPL(prefix##_mapped_array);                      \
+    }                                                                                  \
+                                                                                       \
+    bool prefix##_mapped_array_push(                                                   \
+        name##MappedArray *prefix##_mapped_array, type item)                           \
+    {                                                                                  \
+        const size_t count =                                                           \
+            prefix##_mapped_array_get_count(prefix##_mapped_array);                    \
+                                                                                       \
+        if (count == prefix##_mapped_array->capacity)                                  \
+        {                                                                              \
+            /* A file holding only the header opens with capacity 0 */                 \
+            const size_t new_capacity = prefix##_mapped_array->capacity                \
+                ? ARRAY_GROWTH_DOUBLE(prefix##_mapped_array->capacity)                 \
+                : 1;                                                                   \
+                                                                                       \
+            if (new_capacity <= prefix##_mapped_array->capacity                        \
+                || !prefix##_mapped_array_fits_impl(new_capacity))                     \
+            {                                                                          \
+                ARRAY_SET_ERROR_IMPL(                                                  \
+                    prefix##_mapped_array, ARRAY_ERROR_TYPE_OVERFLOW);                 \
+                ARRAY_MACROS_REPORT(                                                   \
+                    "%s: Capacity (%zu) cannot grow without overflow\n",               \
+                    __func__,                                                          \
+                    prefix##_mapped_array->capacity);                                  \
+                return false;                                                          \
+            }                                                                          \
+                                                                                       \
+            if (!prefix##_mapped_array_resize_impl(                                    \
+                    prefix##_mapped_array, new_capacity))                              \
+                return false;                                                          \
+        }                                                                              \
+                                                                                       \
+        prefix##_mapped_array->data[count] = item;                                     \
+        prefix##_mapped_array->header->count = count + 1;                              \
+                                                                                       \
+        return true;                                                                   \
+    }                                                                                  \
+                                                                                       \
+    bool prefix##_mapped_array_pop(                                                    \
+        name##MappedArray *prefix##_mapped_array, type *out_item)                      \
+    {                                                                                  \
+        const size_t count =                                                           \
+            prefix##_mapped_array_get_count(prefix##_mapped_array);                    \
+                                                                                       \
+        if (count == 0)                                                                \
+        {                                                                              \
+            ARRAY_SET_ERROR_IMPL(prefix##_mapped_array, ARRAY_ERROR_TYPE_EMPTY);       \
+            ARRAY_MACROS_REPORT("%s: Array is empty (count 0)\n", __func__);           \
+            return false;                                                              \
+        }                                                                              \
+                                                                                       \
+        if (out_item)                                                                  \
+            *out_item = prefix##_mapped_array->data[count - 1];                        \
+        prefix##_mapped_array->header->count = count - 1;                              \
+                                                                                       \
+        return true;                                                                   \
+    }                                                                                  \
+                                                                                       \
+    bool prefix##_mapped_array_set(                                                    \
+        name##MappedArray *prefix##_mapped_array, size_t index, type item)             \
+    {                                                                                  \
+        const size_t count =                                                           \
+            prefix##_mapped_array_get_count(prefix##_mapped_array);                    \
+                                                                                       \
+        if (index >= count)                                                            \
+        {                                                                              \
+            ARRAY_SET_ERROR_IMPL(                                                      \
+                prefix##_mapped_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);                \
+            ARRAY_MACROS_REPORT(                                                       \
+                "%s: Index (%zu) out of bounds (%zu)\n",                               \
+                __func__,                                                              \
+                index,                                                                 \
+                count);                                                                \
+            return false;                                                              \
+        }                                                                              \
+                                                                                       \
+        prefix##_mapped_array->data[index] = item;                                     \
+                                                                                       \
+        return true;                                                                   \
+    }                                                                                  \
+                                                                                       \
+    bool prefix##_mapped_array_get(                                                    \
+        name##MappedArray *prefix##_mapped_array,                                      \
+        size_t index,                                                                  \
+        type *out_item)                                                                \
+    {                                                                                  \
+        const size_t count =                                                           \
+            prefix##_mapped_array_get_count(prefix##_mapped_array);                    \
+                                                                                       \
+        if (index >= count)                                                            \
+        {                                                                              \
+            ARRAY_SET_ERROR_IMPL(                                                      \
+                prefix##_mapped_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);                \
+            ARRAY_MACROS_REPORT(                                                       \
+                "%s: Index (%zu) out of bounds (%zu)\n",                               \
+                __func__,                                                              \
+                index,                                                                 \
+                count);                                                                \
+            return false;                                                              \
+        }                                                                              \
+                                                                                       \
+        *out_item = prefix##_mapped_array->data[index];                                \
+                                                                                       \
+        return true;                                                                   \
+    }                                                                                  \
+                                                                                       \
+    void prefix##_mapped_array_clear(name##MappedArray *prefix##_mapped_array)         \
+    {                                                                                  \
+        prefix##_mapped_array->header->count = 0;                                      \
+    }                                                                                  \
+                                                                                       \
+    bool prefix##_mapped_array_reserve(                                                \
+        name##MappedArray *prefix##_mapped_array, size_t capacity)                     \
+    {                                                                                  \
+        if (capacity <= prefix##_mapped_array->capacity)                               \
+            return true;                                                               \
+                                                                                       \
+        if (!prefix##_mapped_array_fits_impl(capacity))                                \
+        {                                                                              \
+            ARRAY_SET_ERROR_IMPL(prefix##_mapped_array, ARRAY_ERROR_TYPE_OVERFLOW);    \
+            ARRAY_MACROS_REPORT(                                                       \
+                "%s: Capacity (%zu) is too large\n",                                   \
+                __func__,                                                              \
+                capacity);                                                             \
+            return false;                                                              \
+        }                                                                              \
+                                                                                       \
+        return prefix##_mapped_array_resize_impl(prefix##_mapped_array, capacity);     \
+    }                                                                                  \
+                                                                                       \
+    static inline bool prefix##_mapped_array_resize_impl(                              \
+        name##MappedArray *prefix##_mapped_array, size_t new_capacity)                 \
+    {                                                                                  \
+        const size_t old_size = prefix##_mapped_array_file_size_impl(                  \
+            prefix##_mapped_array->capacity);                                          \
+        const size_t new_size =                                                        \
+            prefix##_mapped_array_file_size_impl(new_capacity);                        \
+                                                                                       \
+        if (ftruncate(prefix##_mapped_array->fd, (off_t)new_size))                     \
+        {                                                                              \
+            ARRAY_SET_ERROR_IMPL(prefix##_mapped_array, ARRAY_ERROR_TYPE_IO);          \
+            ARRAY_MACROS_REPORT_ERRNO(                                                 \
+                #prefix "_mapped_array_resize_impl: Error with ftruncate");            \
+            return false;                                                              \
+        }                                                                              \
+                                                                                       \
+        void *map = array_mapped_remap_impl(                                           \
+            prefix##_mapped_array->fd,                                                 \
+            prefix##_mapped_array->header,                                             \
+            old_size,                                                                  \
+            new_size);                                                                 \
+                                                                                       \
+        if (map == MAP_FAILED)                                                         \
+        {                                                                              \
+            ARRAY_SET_ERROR_IMPL(prefix##_mapped_array, ARRAY_ERROR_TYPE_ALLOCATION);  \
+            ARRAY_MACROS_REPORT_ERRNO(                                                 \
+                #prefix "_mapped_array_resize_impl: Error remapping file");            \
+            return false;                                                              \
+        }                                                                              \
+                                                                                       \
+        prefix##_mapped_array_attach_impl(                                             \
+            prefix##_mapped_array, map, new_capacity);                                 \
+        ARRAY_STATS_ADD_IMPL(prefix##_mapped_array, reallocs, 1);                      \
+        ARRAY_STATS_PEAK_IMPL(prefix##_mapped_array);                                  \
+                                                                                       \
+        return true;                                                                   \
+    }
+
+#endif // ARRAY_MACROS_MAPPED_ARRAY_MACROS_H
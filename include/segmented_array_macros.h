@@ -0,0 +1,386 @@
+/*
+ * array-macros
+ * Copyright (C) 2025  Thomas George Hodgkinson
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARRAY_MACROS_SEGMENTED_ARRAY_MACROS_H
+#define ARRAY_MACROS_SEGMENTED_ARRAY_MACROS_H
+
+#include <limits.h> // for CHAR_BIT
+#include <stdbool.h>
+#include <stddef.h> // for size_t
+#include <stdint.h> // for SIZE_MAX
+
+#include "array_macros.h"
+
+/*
+ * An array that grows by adding chunks instead of reallocating. With a
+ * base chunk size B (a power of two), chunk k holds B << k elements, so
+ * chunk k starts at index B * (2^k - 1). Elements never move once pushed,
+ * which keeps pointers to them valid and avoids the copy spike of a
+ * realloc. Indexing finds the chunk with one bit scan.
+ */
+
+#define SEGMENTED_ARRAY_MAX_CHUNKS (sizeof(size_t) * CHAR_BIT)
+
+static inline size_t segmented_array_floor_log2_impl(size_t value)
+{
+#if defined(__GNUC__)
+    return sizeof(unsigned long long) * CHAR_BIT - 1
+        - (size_t)__builtin_clzll((unsigned long long)value);
+#else
+    size_t result = 0;
+
+    while (value >>= 1)
+        result++;
+
+    return result;
+#endif
+}
+
+#define DECLARE_SEGMENTED_ARRAY_STRUCT(prefix, name) \
+    typedef struct prefix##_segmented_array name##SegmentedArray;
+
+#define DECLARE_SEGMENTED_ARRAY_FUNCTIONS(prefix, name, type)                \
+    name##SegmentedArray *prefix##_segmented_array_create(                   \
+        size_t initial_capacity);                                            \
+    name##SegmentedArray *prefix##_segmented_array_create_with_allocator(    \
+        size_t initial_capacity, const ArrayAllocator *allocator);           \
+    void prefix##_segmented_array_free(                                      \
+        name##SegmentedArray *prefix##_segmented_array);                     \
+                                                                             \
+    size_t prefix##_segmented_array_get_count(                               \
+        const name##SegmentedArray *prefix##_segmented_array);               \
+    size_t prefix##_segmented_array_get_capacity(                            \
+        const name##SegmentedArray *prefix##_segmented_array);               \
+    ArrayErrorType prefix##_segmented_array_get_last_error(                  \
+        const name##SegmentedArray *prefix##_segmented_array);               \
+    void prefix##_segmented_array_get_stats(                                 \
+        const name##SegmentedArray *prefix##_segmented_array,                \
+        ArrayStats *out_stats);                                              \
+                                                                             \
+    bool prefix##_segmented_array_push(                                      \
+        name##SegmentedArray *prefix##_segmented_array, type item);          \
+    bool prefix##_segmented_array_pop(                                       \
+        name##SegmentedArray *prefix##_segmented_array, type *out_item);     \
+    bool prefix##_segmented_array_set(                                       \
+        name##SegmentedArray *prefix##_segmented_array,                      \
+        size_t index,                                                        \
+        type item);                                                          \
+    bool prefix##_segmented_array_get(                                       \
+        name##SegmentedArray *prefix##_segmented_array,                      \
+        size_t index,                                                        \
+        type *out_item);                                                     \
+    const type *prefix##_segmented_array_get_ptr(                            \
+        const name##SegmentedArray *prefix##_segmented_array, size_t index); \
+    type *prefix##_segmented_array_get_ptr_mut(                              \
+        name##SegmentedArray *prefix##_segmented_array, size_t index);       \
+    bool prefix##_segmented_array_is_empty(                                  \
+        const name##SegmentedArray *prefix##_segmented_array);               \
+    void prefix##_segmented_array_clear(                                     \
+        name##SegmentedArray *prefix##_segmented_array);                     \
+    bool prefix##_segmented_array_reserve(                                   \
+        name##SegmentedArray *prefix##_segmented_array, size_t capacity);
+
+#define DEFINE_SEGMENTED_ARRAY_STRUCT(prefix, name, type) \
+    typedef struct prefix##_segmented_array               \
+    {                                                     \
+        type *chunks[SEGMENTED_ARRAY_MAX_CHUNKS];         \
+        size_t chunk_count;                               \
+        size_t base_shift;                                \
+        size_t count;                                     \
+        size_t capacity;                                  \
+        ArrayErrorType last_error;                        \
+        const ArrayAllocator *allocator;                  \
+        ARRAY_STATS_FIELD_IMPL                            \
+    } name##SegmentedArray;
+
+#define DEFINE_SEGMENTED_ARRAY_FUNCTIONS(prefix, name, type)                        \
+    static inline bool prefix##_segmented_array_add_chunk_impl(                     \
+        name##SegmentedArray *prefix##_segmented_array);                            \
+                                                                                    \
+    static inline type *prefix##_segmented_array_slot_impl(                         \
+        const name##SegmentedArray *prefix##_segmented_array, size_t index)         \
+    {                                                                               \
+        const size_t shift = prefix##_segmented_array->base_shift;                  \
+        const size_t chunk =                                                        \
+            segmented_array_floor_log2_impl((index >> shift) + 1);                  \
+        const size_t offset =                                                       \
+            index + ((size_t)1 << shift) - ((size_t)1 << (shift + chunk));          \
+                                                                                    \
+        return &prefix##_segmented_array->chunks[chunk][offset];                    \
+    }                                                                               \
+                                                                                    \
+    name##SegmentedArray *prefix##_segmented_array_create_with_allocator(           \
+        size_t initial_capacity, const ArrayAllocator *allocator)                   \
+    {                                                                               \
+        if (!initial_capacity)                                                      \
+        {                                                                           \
+            ARRAY_MACROS_REPORT(                                                    \
+                "%s: Initial capacity cannot be 0\n",                               \
+                __func__);                                                          \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        size_t base_shift = segmented_array_floor_log2_impl(initial_capacity);      \
+        if (initial_capacity & (initial_capacity - 1))                              \
+            base_shift++;                                                           \
+                                                                                    \
+        if (base_shift >= SEGMENTED_ARRAY_MAX_CHUNKS                                \
+            || ((size_t)1 << base_shift) > SIZE_MAX / sizeof(type))                 \
+        {                                                                           \
+            ARRAY_MACROS_REPORT(                                                    \
+                "%s: Initial capacity (%zu) is too large\n",                        \
+                __func__,                                                           \
+                initial_capacity);                                                  \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        name##SegmentedArray *prefix##_segmented_array =                            \
+            array_allocator_allocate_impl(                                          \
+                allocator, sizeof(*prefix##_segmented_array));                      \
+        if (!prefix##_segmented_array)                                              \
+        {                                                                           \
+            ARRAY_MACROS_REPORT_ERRNO(                                              \
+                #prefix "_segmented_array allocation failure");                     \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        prefix##_segmented_array->chunk_count = 0;                                  \
+        prefix##_segmented_array->base_shift = base_shift;                          \
+        prefix##_segmented_array->count = 0;                                        \
+        prefix##_segmented_array->capacity = 0;                                     \
+        prefix##_segmented_array->last_error = ARRAY_ERROR_TYPE_NONE;               \
+        prefix##_segmented_array->allocator = allocator;                            \
+                                                                                    \
+        ARRAY_STATS_INIT_IMPL(prefix##_segmented_array);                            \
+                                                                                    \
+        if (!prefix##_segmented_array_add_chunk_impl(prefix##_segmented_array))     \
+        {                                                                           \
+            array_allocator_deallocate_impl(                                        \
+                allocator, prefix##_segmented_array);                               \
+            return NULL;                                                            \
+        }                                                                           \
+                                                                                    \
+        return prefix##_segmented_array;                                            \
+    }                                                                               \
+                                                                                    \
+    name##SegmentedArray *prefix##_segmented_array_create(                          \
+        size_t initial_capacity)                                                    \
+    {                                                                               \
+        return prefix##_segmented_array_create_with_allocator(                      \
+            initial_capacity, NULL);                                                \
+    }                                                                               \
+                                                                                    \
+    void prefix##_segmented_array_free(                                             \
+        name##SegmentedArray *prefix##_segmented_array)                             \
+    {                                                                               \
+        const ArrayAllocator *allocator = prefix##_segmented_array->allocator;      \
+                                                                                    \
+        for (size_t i = 0; i < prefix##_segmented_array->chunk_count; i++)          \
+            array_allocator_deallocate_impl(                                        \
+                allocator, prefix##_segmented_array->chunks[i]);                    \
+        array_allocator_deallocate_impl(allocator, prefix##_segmented_array);       \
+    }                                                                               \
+                                                                                    \
+    size_t prefix##_segmented_array_get_count(                                      \
+        const name##SegmentedArray *prefix##_segmented_array)                       \
+    {                                                                               \
+        return prefix##_segmented_array->count;                                     \
+    }                                                                               \
+                                                                                    \
+    size_t prefix##_segmented_array_get_capacity(                                   \
+        const name##SegmentedArray *prefix##_segmented_array)                       \
+    {                                                                               \
+        return prefix##_segmented_array->capacity;                                  \
+    }                                                                               \
+                                                                                    \
+    ArrayErrorType prefix##_segmented_array_get_last_error(                         \
+        const name##SegmentedArray *prefix##_segmented_array)                       \
+    {                                                                               \
+        return prefix##_segmented_array->last_error;                                \
+    }                                                                               \
+                                                                                    \
+    void prefix##_segmented_array_get_stats(                                        \
+        const name##SegmentedArray *prefix##_segmented_array,                       \
+        ArrayStats *out_stats)                                                      \
+    {                                                                               \
+        *out_stats = ARRAY_STATS_GET_IMPL(prefix##_segmented_array);                \
+    }                                                                               \
+                                                                                    \
+    bool prefix##_segmented_array_push(                                             \
+        name##SegmentedArray *prefix##_segmented_array, type item)                  \
+    {                                                                               \
+        if (prefix##_segmented_array->count                                         \
+                == prefix##_segmented_array->capacity                               \
+            && !prefix##_segmented_array_add_chunk_impl(                            \
+                prefix##_segmented_array))                                          \
+            return false;                                                           \
+                                                                                    \
+        *prefix##_segmented_array_slot_impl(                                        \
+            prefix##_segmented_array, prefix##_segmented_array->count++) = item;    \
+                                                                                    \
+        return true;                                                                \
+    }                                                                               \
+                                                                                    \
+    bool prefix##_segmented_array_pop(                                              \
+        name##SegmentedArray *prefix##_segmented_array, type *out_item)             \
+    {                                                                               \
+        if (prefix##_segmented_array->count == 0)                                   \
+        {                                                                           \
+            ARRAY_SET_ERROR_IMPL(prefix##_segmented_array, ARRAY_ERROR_TYPE_EMPTY); \
+            ARRAY_MACROS_REPORT("%s: Array is empty (count 0)\n", __func__);        \
+            return false;                                                           \
+        }                                                                           \
+                                                                                    \
+        prefix##_segmented_array->count--;                                          \
+                                                                                    \
+        if (out_item)                                                               \
+            *out_item = *prefix##_segmented_array_slot_impl(                        \
+                prefix##_segmented_array, prefix##_segmented_array->count);         \
+                                                                                    \
+        return true;                                                                \
+    }                                                                               \
+                                                                                    \
+    bool prefix##_segmented_array_set(                                              \
+        name##SegmentedArray *prefix##_segmented_array,                             \
+        size_t index,                                                               \
+        type item)                                                                  \
+    {                                                                               \
+        if (index >= prefix##_segmented_array->count)                               \
+        {                                                                           \
+            ARRAY_SET_ERROR_IMPL(                                                   \
+                prefix##_segmented_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);          \
+            ARRAY_MACROS_REPORT(                                                    \
+                "%s: Index (%zu) out of bounds (%zu)\n",                            \
+                __func__,                                                           \
+                index,                                                              \
+                prefix##_segmented_array->count);                                   \
+            return false;                                                           \
+        }                                                                           \
+                                                                                    \
+        *prefix##_segmented_array_slot_impl(prefix##_segmented_array, index) =      \
+            item;                                                                   \
+                                                                                    \
+        return true;                                                                \
+    }                                                                               \
+                                                                                    \
+    bool prefix##_segmented_array_get(                                              \
+        name##SegmentedArray *prefix##_segmented_array,                             \
+        size_t index,                                                               \
+        type *out_item)                                                             \
+    {                                                                               \
+        if (index >= prefix##_segmented_array->count)                               \
+        {                                                                           \
+            ARRAY_SET_ERROR_IMPL(                                                   \
+                prefix##_segmented_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);          \
+            ARRAY_MACROS_REPORT(                                                    \
+                "%s: Index (%zu) out of bounds (%zu)\n",                            \
+                __func__,                                                           \
+                index,                                                              \
+                prefix##_segmented_array->count);                                   \
+            return false;                                                           \
+        }                                                                           \
+                                                                                    \
+        *out_item =                                                                 \
+            *prefix##_segmented_array_slot_impl(prefix##_segmented_array, index);   \
+                                                                                    \
+        return true;                                                                \
+    }                                                                               \
+                                                                                    \
+    const type *prefix##_segmented_array_get_ptr(                                   \
+        const name##SegmentedArray *prefix##_segmented_array, size_t index)         \
+    {                                                                               \
+        if (index >= prefix##_segmented_array->count)                               \
+            return NULL;                                                            \
+                                                                                    \
+        return prefix##_segmented_array_slot_impl(prefix##_segmented_array, index); \
+    }                                                                               \
+                                                                                    \
+    type *prefix##_segmented_array_get_ptr_mut(                                     \
+        name##SegmentedArray *prefix##_segmented_array, size_t index)               \
+    {                                                                               \
+        if (index >= prefix##_segmented_array->count)                               \
+            return NULL;                                                            \
+                                                                                    \
+        return prefix##_segmented_array_slot_impl(prefix##_segmented_array, index); \
+    }                                                                               \
+                                                                                    \
+    bool prefix##_segmented_array_is_empty(                                         \
+        const name##SegmentedArray *prefix##_segmented_array)                       \
+    {                                                                               \
+        return !prefix##_segmented_array->count;                                    \
+    }                                                                               \
+                                                                                    \
+    void prefix##_segmented_array_clear(                                            \
+        name##SegmentedArray *prefix##_segmented_array)                             \
+    {                                                                               \
+        prefix##_segmented_array->count = 0;                                        \
+    }                                                                               \
+                                                                                    \
+    bool prefix##_segmented_array_reserve(                                          \
+        name##SegmentedArray *prefix##_segmented_array, size_t capacity)            \
+    {                                                                               \
+        while (prefix##_segmented_array->capacity < capacity)                       \
+        {                                                                           \
+            if (!prefix##_segmented_array_add_chunk_impl(                           \
+                    prefix##_segmented_array))                                      \
+                return false;                                                       \
+        }                                                                           \
+                                                                                    \
+        return true;                                                                \
+    }                                                                               \
+                                                                                    \
+    static inline bool prefix##_segmented_array_add_chunk_impl(                     \
+        name##SegmentedArray *prefix##_segmented_array)                             \
+    {                                                                               \
+        const size_t chunk = prefix##_segmented_array->chunk_count;                 \
+        const size_t shift = prefix##_segmented_array->base_shift + chunk;          \
+                                                                                    \
+        if (shift >= SEGMENTED_ARRAY_MAX_CHUNKS - 1                                 \
+            || ((size_t)1 << shift) > SIZE_MAX / sizeof(type))                      \
+        {                                                                           \
+            ARRAY_SET_ERROR_IMPL(                                                   \
+                prefix##_segmented_array, ARRAY_ERROR_TYPE_OVERFLOW);               \
+            ARRAY_MACROS_REPORT(                                                    \
+                "%s: Capacity (%zu) cannot grow without overflow\n",                \
+                __func__,                                                           \
+                prefix##_segmented_array->capacity);                                \
+            return false;                                                           \
+        }                                                                           \
+                                                                                    \
+        const size_t chunk_capacity = (size_t)1 << shift;                           \
+        type *data = array_allocator_allocate_impl(                                 \
+            prefix##_segmented_array->allocator,                                    \
+            chunk_capacity * sizeof(type));                                         \
+        if (!data)                                                                  \
+        {                                                                           \
+            ARRAY_SET_ERROR_IMPL(                                                   \
+                prefix##_segmented_array, ARRAY_ERROR_TYPE_ALLOCATION);             \
+            ARRAY_MACROS_REPORT_ERRNO(                                              \
+                #prefix "_segmented_array_add_chunk_impl: Error with allocation");  \
+            return false;                                                           \
+        }                                                                           \
+                                                                                    \
+        prefix##_segmented_array->chunks[chunk] = data;                             \
+        prefix##_segmented_array->chunk_count++;                                    \
+        prefix##_segmented_array->capacity += chunk_capacity;                       \
+        ARRAY_STATS_PEAK_IMPL(prefix##_segmented_array);                            \
+                                                                                    \
+        return true;                                                                \
+    }
+
+#endif // ARRAY_MACROS_SEGMENTED_ARRAY_MACROS_H
@@ -0,0 +1,520 @@
+/*
+ * array-macros
+ * Copyright (C) 2025  Thomas George Hodgkinson
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARRAY_MACROS_SOA_ARRAY_MACROS_H
+#define ARRAY_MACROS_SOA_ARRAY_MACROS_H
+
+#include <stdbool.h>
+#include <stddef.h> // for size_t
+#include <stdint.h> // for SIZE_MAX, uintptr_t
+#include <string.h>
+
+#include "array_macros.h"
+
+/*
+ * A struct-of-arrays container: each field of a record is stored in its
+ * own contiguous column, so a loop over one field only loads that field.
+ * The fields are given as an X-macro that applies X to each (type, field):
+ *
+ *     #define PARTICLE_FIELDS(X) X(float, x) X(float, y) X(int, id)
+ *
+ *     DECLARE_SOA_ARRAY_STRUCT(particle, Particle, PARTICLE_FIELDS)
+ *     DECLARE_SOA_ARRAY_FUNCTIONS(particle, Particle, PARTICLE_FIELDS)
+ *
+ * This generates the record type Particle, ParticleColumns and
+ * ParticleConstColumns structs with one pointer per column, and
+ * ParticleSoaArray. Whole records go in and
+ * out through push, insert, get and set. get_columns hands out const
+ * column pointers for scans, and get_columns_mut writable ones.
+ *
+ * All columns live in one allocation, each starting on a
+ * SOA_ARRAY_COLUMN_ALIGNMENT boundary, so growing is a single allocation
+ * and column pointers are safe for aligned vector loads. Growth moves the
+ * columns, so pointers from get_columns are invalidated by any call that
+ * may grow the array.
+ */
+
+#define SOA_ARRAY_COLUMN_ALIGNMENT ((size_t)64)
+
+/* Field callbacks, expanded once per field inside the generated code. */
+#define SOA_ARRAY_RECORD_FIELD_IMPL(type, field) type field;
+#define SOA_ARRAY_COLUMN_FIELD_IMPL(type, field) type *field;
+#define SOA_ARRAY_CONST_COLUMN_FIELD_IMPL(type, field) const type *field;
+#define SOA_ARRAY_VIEW_FIELD_IMPL(type, field) columns.field = source->field;
+#define SOA_ARRAY_RECORD_BYTES_FIELD_IMPL(type, field) + sizeof(type)
+#define SOA_ARRAY_SIZE_FIELD_IMPL(type, field) \
+    && soa_array_add_column_size_impl(&size, capacity, sizeof(type))
+#define SOA_ARRAY_CARVE_FIELD_IMPL(type, field)       \
+    columns->field = (type *)(void *)(base + offset); \
+    offset += soa_array_column_bytes_impl(capacity, sizeof(type));
+#define SOA_ARRAY_COPY_FIELD_IMPL(type, field) \
+    memcpy(columns->field, source->field, count * sizeof(type));
+#define SOA_ARRAY_STORE_FIELD_IMPL(type, field) \
+    columns->field[index] = item.field;
+#define SOA_ARRAY_LOAD_FIELD_IMPL(type, field) \
+    out_item->field = columns->field[index];
+#define SOA_ARRAY_SHIFT_UP_FIELD_IMPL(type, field) \
+    memmove(                                       \
+        &columns->field[index + 1],                \
+        &columns->field[index],                    \
+        (count - index) * sizeof(type));
+#define SOA_ARRAY_SHIFT_DOWN_FIELD_IMPL(type, field) \
+    memmove(                                         \
+        &columns->field[index],                      \
+        &columns->field[index + 1],                  \
+        (count - index - 1) * sizeof(type));
+
+static inline size_t soa_array_column_bytes_impl(
+    size_t capacity, size_t element_size)
+{
+    const size_t bytes = capacity * element_size;
+
+    return (bytes + SOA_ARRAY_COLUMN_ALIGNMENT - 1)
+        & ~(SOA_ARRAY_COLUMN_ALIGNMENT - 1);
+}
+
+static inline bool soa_array_add_column_size_impl(
+    size_t *size, size_t capacity, size_t element_size)
+{
+    if (capacity > (SIZE_MAX - SOA_ARRAY_COLUMN_ALIGNMENT) / element_size)
+        return false;
+
+    const size_t bytes = soa_array_column_bytes_impl(capacity, element_size);
+    if (bytes > SIZE_MAX - *size)
+        return false;
+
+    *size += bytes;
+
+    return true;
+}
+
+#define DECLARE_SOA_ARRAY_STRUCT(prefix, name, fields) \
+    typedef struct prefix##_soa_record                 \
+    {                                                  \
+        fields(SOA_ARRAY_RECORD_FIELD_IMPL)            \
+    } name;                                            \
+                                                       \
+    typedef struct prefix##_soa_columns                \
+    {                                                  \
+        fields(SOA_ARRAY_COLUMN_FIELD_IMPL)            \
+    } name##Columns;                                   \
+                                                       \
+    typedef struct prefix##_soa_const_columns          \
+    {                                                  \
+        fields(SOA_ARRAY_CONST_COLUMN_FIELD_IMPL)      \
+    } name##ConstColumns;                              \
+                                                       \
+    typedef struct prefix##_soa_array name##SoaArray;
+
+#define DECLARE_SOA_ARRAY_FUNCTIONS(prefix, name, fields)                        \
+    name##SoaArray *prefix##_soa_array_create(size_t initial_capacity);          \
+    name##SoaArray *prefix##_soa_array_create_with_allocator(                    \
+        size_t initial_capacity, const ArrayAllocator *allocator);               \
+    void prefix##_soa_array_free(name##SoaArray *prefix##_soa_array);            \
+                                                                                 \
+    size_t prefix##_soa_array_get_count(                                         \
+        const name##SoaArray *prefix##_soa_array);                               \
+    size_t prefix##_soa_array_get_capacity(                                      \
+        const name##SoaArray *prefix##_soa_array);                               \
+    name##ConstColumns prefix##_soa_array_get_columns(                           \
+        const name##SoaArray *prefix##_soa_array);                               \
+    name##Columns prefix##_soa_array_get_columns_mut(                            \
+        name##SoaArray *prefix##_soa_array);                                     \
+    ArrayErrorType prefix##_soa_array_get_last_error(                            \
+        const name##SoaArray *prefix##_soa_array);                               \
+    void prefix##_soa_array_get_stats(                                           \
+        const name##SoaArray *prefix##_soa_array, ArrayStats *out_stats);        \
+                                                                                 \
+    bool prefix##_soa_array_push(name##SoaArray *prefix##_soa_array, name item); \
+    bool prefix##_soa_array_insert(                                              \
+        name##SoaArray *prefix##_soa_array, size_t index, name item);            \
+    bool prefix##_soa_array_set(                                                 \
+        name##SoaArray *prefix##_soa_array, size_t index, name item);            \
+    bool prefix##_soa_array_remove(                                              \
+        name##SoaArray *prefix##_soa_array, size_t index);                       \
+    bool prefix##_soa_array_get(                                                 \
+        name##SoaArray *prefix##_soa_array, size_t index, name *out_item);       \
+    bool prefix##_soa_array_is_empty(const name##SoaArray *prefix##_soa_array);  \
+    void prefix##_soa_array_clear(name##SoaArray *prefix##_soa_array);           \
+    bool prefix##_soa_array_reserve(                                             \
+        name##SoaArray *prefix##_soa_array, size_t capacity);
+
+#define DEFINE_SOA_ARRAY_STRUCT(prefix, name, fields) \
+    typedef struct prefix##_soa_array                 \
+    {                                                 \
+        name##Columns columns;                        \
+        void *block;                                  \
+        size_t count;                                 \
+        size_t capacity;                              \
+        ArrayErrorType last_error;                    \
+        const ArrayAllocator *allocator;              \
+        ARRAY_STATS_FIELD_IMPL                        \
+    } name##SoaArray;
+
+#define DEFINE_SOA_ARRAY_FUNCTIONS(prefix, name, fields)                         \
+    static inline bool prefix##_soa_array_grow_impl(                             \
+        name##SoaArray *prefix##_soa_array);                                     \
+    static inline bool prefix##_soa_array_resize_impl(                           \
+        name##SoaArray *prefix##_soa_array, size_t capacity);                    \
+                                                                                 \
+    /* Bytes for every column, plus slack to align the first one. */             \
+    static inline bool prefix##_soa_array_block_size_impl(                       \
+        size_t capacity, size_t *out_size)                                       \
+    {                                                                            \
+        size_t size = SOA_ARRAY_COLUMN_ALIGNMENT - 1;                            \
+        const bool fits = true fields(SOA_ARRAY_SIZE_FIELD_IMPL);                \
+                                                                                 \
+        if (!fits)                                                               \
+        {                                                                        \
+            ARRAY_MACROS_REPORT(                                                 \
+                "%s: Capacity (%zu) would overflow\n",                           \
+                __func__,                                                        \
+                capacity);                                                       \
+            return false;                                                        \
+        }                                                                        \
+                                                                                 \
+        *out_size = size;                                                        \
+                                                                                 \
+        return true;                                                             \
+    }                                                                            \
+                                                                                 \
+    /* Allocates one block holding every column and points columns at it. */     \
+    static inline void *prefix##_soa_array_allocate_impl(                        \
+        const ArrayAllocator *allocator,                                         \
+        size_t capacity,                                                         \
+        size_t size,                                                             \
+        name##Columns *columns)                                                  \
+    {                                                                            \
+        void *block = array_allocator_allocate_impl(allocator, size);            \
+        if (!block)                                                              \
+        {                                                                        \
+            ARRAY_MACROS_REPORT_ERRNO(                                           \
+                #prefix "_soa_array_allocate_impl: Error with allocation");      \
+            return NULL;                                                         \
+        }                                                                        \
+                                                                                 \
+        unsigned char *base = block;                                             \
+        base += (SOA_ARRAY_COLUMN_ALIGNMENT                                      \
+                 - (uintptr_t)base % SOA_ARRAY_COLUMN_ALIGNMENT)                 \
+            % SOA_ARRAY_COLUMN_ALIGNMENT;                                        \
+        size_t offset = 0;                                                       \
+        fields(SOA_ARRAY_CARVE_FIELD_IMPL)                                       \
+                                                                                 \
+        return block;                                                            \
+    }                                                                            \
+                                                                                 \
+    name##SoaArray *prefix##_soa_array_create_with_allocator(                    \
+        size_t initial_capacity, const ArrayAllocator *allocator)                \
+    {                                                                            \
+        if (!initial_capacity)                                                   \
+        {                                                                        \
+            ARRAY_MACROS_REPORT(                                                 \
+                "%s: Initial capacity cannot be 0\n",                            \
+                __func__);                                                       \
+            return NULL;                                                         \
+        }                                                                        \
+                                                                                 \
+        size_t size;                                                             \
+        if (!prefix##_soa_array_block_size_impl(initial_capacity, &size))        \
+            return NULL;                                                         \
+                                                                                 \
+        name##SoaArray *prefix##_soa_array = array_allocator_allocate_impl(      \
+            allocator, sizeof(*prefix##_soa_array));                             \
+        if (!prefix##_soa_array)                                                 \
+        {                                                                        \
+            ARRAY_MACROS_REPORT_ERRNO(#prefix "_soa_array allocation failure");  \
+            return NULL;                                                         \
+        }                                                                        \
+                                                                                 \
+        prefix##_soa_array->block = prefix##_soa_array_allocate_impl(            \
+            allocator, initial_capacity, size, &prefix##_soa_array->columns);    \
+        if (!prefix##_soa_array->block)                                          \
+        {                                                                        \
+            array_allocator_deallocate_impl(allocator, prefix##_soa_array);      \
+            return NULL;                                                         \
+        }                                                                        \
+                                                                                 \
+        prefix##_soa_array->count = 0;                                           \
+        prefix##_soa_array->capacity = initial_capacity;                         \
+        prefix##_soa_array->last_error = ARRAY_ERROR_TYPE_NONE;                  \
+        prefix##_soa_array->allocator = allocator;                               \
+        ARRAY_STATS_INIT_IMPL(prefix##_soa_array);                               \
+                                                                                 \
+        return prefix##_soa_array;                                               \
+    }                                                                            \
+                                                                                 \
+    name##SoaArray *prefix##_soa_array_create(size_t initial_capacity)           \
+    {                                                                            \
+        return prefix##_soa_array_create_with_allocator(initial_capacity, NULL); \
+    }                                                                            \
+                                                                                 \
+    void prefix##_soa_array_free(name##SoaArray *prefix##_soa_array)             \
+    {                                                                            \
+        const ArrayAllocator *allocator = prefix##_soa_array->allocator;         \
+                                                                                 \
+        array_allocator_deallocate_impl(allocator, prefix##_soa_array->block);   \
+        array_allocator_deallocate_impl(allocator, prefix##_soa_array);          \
+    }                                                                            \
+                                                                                 \
+    size_t prefix##_soa_array_get_count(                                         \
+        const name##SoaArray *prefix##_soa_array)                                \
+    {                                                                            \
+        return prefix##_soa_array->count;                                        \
+    }                                                                            \
+                                                                                 \
+    size_t prefix##_soa_array_get_capacity(                                      \
+        const name##SoaArray *prefix##_soa_array)                                \
+    {                                                                            \
+        return prefix##_soa_array->capacity;                                     \
+    }                                                                            \
+                                                                                 \
+    name##ConstColumns prefix##_soa_array_get_columns(                           \
+        const name##SoaArray *prefix##_soa_array)                                \
+    {                                                                            \
+        const name##Columns *source = &prefix##_soa_array->columns;              \
+        name##ConstColumns columns;                                              \
+        fields(SOA_ARRAY_VIEW_FIELD_IMPL)                                        \
+                                                                                 \
+        return columns;                                                          \
+    }                                                                            \
+                                                                                 \
+    name##Columns prefix##_soa_array_get_columns_mut(                            \
+        name##SoaArray *prefix##_soa_array)                                      \
+    {                                                                            \
+        return prefix##_soa_array->columns;                                      \
+    }                                                                            \
+                                                                                 \
+    ArrayErrorType prefix##_soa_array_get_last_error(                            \
+        const name##SoaArray *prefix##_soa_array)                                \
+    {                                                                            \
+        return prefix##_soa_array->last_error;                                   \
+    }                                                                            \
+                                                                                 \
+    void prefix##_soa_array_get_stats(                                           \
+        const name##SoaArray *prefix##_soa_array, ArrayStats *out_stats)         \
+    {                                                                            \
+        *out_stats = ARRAY_STATS_GET_IMPL(prefix##_soa_array);                   \
+    }                                                                            \
+                                                                                 \
+    bool prefix##_soa_array_push(name##SoaArray *prefix##_soa_array, name item)  \
+    {                                                                            \
+        if (!prefix##_soa_array_grow_impl(prefix##_soa_array))                   \
+            return false;                                                        \
+                                                                                 \
+        name##Columns *columns = &prefix##_soa_array->columns;                   \
+        const size_t index = prefix##_soa_array->count++;                        \
+        fields(SOA_ARRAY_STORE_FIELD_IMPL)                                       \
+                                                                                 \
+        return true;                                                             \
+    }                                                                            \
+                                                                                 \
+    bool prefix##_soa_array_insert(                                              \
+        name##SoaArray *prefix##_soa_array, size_t index, name item)             \
+    {                                                                            \
+        const size_t count = prefix##_soa_array->count;                          \
+                                                                                 \
+        if (index > count)                                                       \
+        {                                                                        \
+            ARRAY_SET_ERROR_IMPL(                                                \
+                prefix##_soa_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);             \
+            ARRAY_MACROS_REPORT(                                                 \
+                "%s: Index (%zu) out of bounds (%zu)\n",                         \
+                __func__,                                                        \
+                index,                                                           \
+                count);                                                          \
+            return false;                                                        \
+        }                                                                        \
+                                                                                 \
+        if (!prefix##_soa_array_grow_impl(prefix##_soa_array))                   \
+            return false;                                                        \
+                                                                                 \
+        name##Columns *columns = &prefix##_soa_array->columns;                   \
+        fields(SOA_ARRAY_SHIFT_UP_FIELD_IMPL)                                    \
+        ARRAY_STATS_ADD_IMPL(                                                    \
+            prefix##_soa_array,                                                  \
+            bytes_moved,                                                         \
+            (count - index) *                                                    \
+                (0 fields(SOA_ARRAY_RECORD_BYTES_FIELD_IMPL)));                  \
+        fields(SOA_ARRAY_STORE_FIELD_IMPL)                                       \
+        prefix##_soa_array->count++;                                             \
+                                                                                 \
+        return true;                                                             \
+    }                                                                            \
+                                                                                 \
+    bool prefix##_soa_array_set(                                                 \
+        name##SoaArray *prefix##_soa_array, size_t index, name item)             \
+    {                                                                            \
+        if (index >= prefix##_soa_array->count)                                  \
+        {                                                                        \
+            ARRAY_SET_ERROR_IMPL(                                                \
+                prefix##_soa_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);             \
+            ARRAY_MACROS_REPORT(                                                 \
+                "%s: Index (%zu) out of bounds (%zu)\n",                         \
+                __func__,                                                        \
+                index,                                                           \
+                prefix##_soa_array->count);                                      \
+            return false;                                                        \
+        }                                                                        \
+                                                                                 \
+        name##Columns *columns = &prefix##_soa_array->columns;                   \
+        fields(SOA_ARRAY_STORE_FIELD_IMPL)                                       \
+                                                                                 \
+        return true;                                                             \
+    }                                                                            \
+                                                                                 \
+    bool prefix##_soa_array_remove(                                              \
+        name##SoaArray *prefix##_soa_array, size_t index)                        \
+    {                                                                            \
+        const size_t count = prefix##_soa_array->count;                          \
+                                                                                 \
+        if (count == 0)                                                          \
+        {                                                                        \
+            ARRAY_SET_ERROR_IMPL(prefix##_soa_array, ARRAY_ERROR_TYPE_EMPTY);    \
+            ARRAY_MACROS_REPORT("%s: Array is empty (count 0)\n", __func__);     \
+            return false;                                                        \
+        }                                                                        \
+                                                                                 \
+        if (index >= count)                                                      \
+        {                                                                        \
+            ARRAY_SET_ERROR_IMPL(                                                \
+                prefix##_soa_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);             \
+            ARRAY_MACROS_REPORT(                                                 \
+                "%s: Index (%zu) out of bounds (%zu)\n",                         \
+                __func__,                                                        \
+                index,                                                           \
+                count);                                                          \
+            return false;                                                        \
+        }                                                                        \
+                                                                                 \
+        name##Columns *columns = &prefix##_soa_array->columns;                   \
+        fields(SOA_ARRAY_SHIFT_DOWN_FIELD_IMPL)                                  \
+        ARRAY_STATS_ADD_IMPL(                                                    \
+            prefix##_soa_array,                                                  \
+            bytes_moved,                                                         \
+            (count - index - 1) *                                                \
+                (0 fields(SOA_ARRAY_RECORD_BYTES_FIELD_IMPL)));                  \
+        prefix##_soa_array->count--;                                             \
+                                                                                 \
+        return true;                                                             \
+    }                                                                            \
+                                                                                 \
+    bool prefix##_soa_array_get(                                                 \
+        name##SoaArray *prefix##_soa_array, size_t index, name *out_item)        \
+    {                                                                            \
+        if (index >= prefix##_soa_array->count)                                  \
+        {                                                                        \
+            ARRAY_SET_ERROR_IMPL(                                                \
+                prefix##_soa_array, ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);             \
+            ARRAY_MACROS_REPORT(                                                 \
+                "%s: Index (%zu) out of bounds (%zu)\n",                         \
+                __func__,                                                        \
+                index,                                                           \
+                prefix##_soa_array->count);                                      \
+            return false;                                                        \
+        }                                                                        \
+                                                                                 \
+        const name##Columns *columns = &prefix##_soa_array->columns;             \
+        fields(SOA_ARRAY_LOAD_FIELD_IMPL)                                        \
+                                                                                 \
+        return true;                                                             \
+    }                                                                            \
+                                                                                 \
+    bool prefix##_soa_array_is_empty(const name##SoaArray *prefix##_soa_array)   \
+    {                                                                            \
+        return prefix##_soa_array->count == 0;                                   \
+    }                                                                            \
+                                                                                 \
+    void prefix##_soa_array_clear(name##SoaArray *prefix##_soa_array)            \
+    {                                                                            \
+        prefix##_soa_array->count = 0;                                           \
+    }                                                                            \
+                                                                                 \
+    bool prefix##_soa_array_reserve(                                             \
+        name##SoaArray *prefix##_soa_array, size_t capacity)                     \
+    {                                                                            \
+        if (capacity <= prefix##_soa_array->capacity)                            \
+            return true;                                                         \
+                                                                                 \
+        return prefix##_soa_array_resize_impl(prefix##_soa_array, capacity);     \
+    }                                                                            \
+                                                                                 \
+    static inline bool prefix##_soa_array_grow_impl(                             \
+        name##SoaArray *prefix##_soa_array)                                      \
+    {                                                                            \
+        if (prefix##_soa_array->count < prefix##_soa_array->capacity)            \
+            return true;                                                         \
+                                                                                 \
+        const size_t new_capacity =                                              \
+            ARRAY_GROWTH_DOUBLE(prefix##_soa_array->capacity);                   \
+        if (new_capacity <= prefix##_soa_array->capacity)                        \
+        {                                                                        \
+            ARRAY_SET_ERROR_IMPL(prefix##_soa_array, ARRAY_ERROR_TYPE_OVERFLOW); \
+            ARRAY_MACROS_REPORT(                                                 \
+                "%s: Capacity (%zu) cannot grow without overflow\n",             \
+                __func__,                                                        \
+                prefix##_soa_array->capacity);                                   \
+            return false;                                                        \
+        }                                                                        \
+                                                                                 \
+        return prefix##_soa_array_resize_impl(prefix##_soa_array, new_capacity); \
+    }                                                                            \
+                                                                                 \
+    /* Columns move to new offsets, so each one is copied into a new block. */   \
+    static inline bool prefix##_soa_array_resize_impl(                           \
+        name##SoaArray *prefix##_soa_array, size_t capacity)                     \
+    {                                                                            \
+        size_t size;                                                             \
+        if (!prefix##_soa_array_block_size_impl(capacity, &size))                \
+        {                                                                        \
+            ARRAY_SET_ERROR_IMPL(prefix##_soa_array, ARRAY_ERROR_TYPE_OVERFLOW); \
+            return false;                                                        \
+        }                                                                        \
+                                                                                 \
+        name##Columns new_columns;                                               \
+        void *block = prefix##_soa_array_allocate_impl(                          \
+            prefix##_soa_array->allocator, capacity, size, &new_columns);        \
+                                                                                 \
+        if (!block)                                                              \
+        {                                                                        \
+            ARRAY_SET_ERROR_IMPL(                                                \
+                prefix##_soa_array, ARRAY_ERROR_TYPE_ALLOCATION);                \
+            return false;                                                        \
+        }                                                                        \
+                                                                                 \
+        name##Columns *columns = &new_columns;                                   \
+        const name##Columns *source = &prefix##_soa_array->columns;              \
+        const size_t count = prefix##_soa_array->count;                          \
+        fields(SOA_ARRAY_COPY_FIELD_IMPL)                                        \
+        ARRAY_STATS_ADD_IMPL(                                                    \
+            prefix##_soa_array,                                                  \
+            bytes_moved,                                                         \
+            count *                                                              \
+                (0 fields(SOA_ARRAY_RECORD_BYTES_FIELD_IMPL)));                  \
+                                                                                 \
+        array_allocator_deallocate_impl(                                         \
+            prefix##_soa_array->allocator, prefix##_soa_array->block);           \
+        prefix##_soa_array->columns = new_columns;                               \
+        prefix##_soa_array->block = block;                                       \
+        prefix##_soa_array->capacity = capacity;                                 \
+        ARRAY_STATS_ADD_IMPL(prefix##_soa_array, reallocs, 1);                   \
+        ARRAY_STATS_PEAK_IMPL(prefix##_soa_array);                               \
+                                                                                 \
+        return true;                                                             \
+    }
+
+#endif // ARRAY_MACROS_SOA_ARRAY_MACROS_H
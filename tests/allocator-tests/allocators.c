@@ -0,0 +1,10 @@
+#include "allocators.h"
+
+#include "allocator_macros.h"
+#include "array_macros.h"
+
+DEFINE_ARENA_ALLOCATOR(test, Test)
+DEFINE_POOL_ALLOCATOR(test, Test)
+
+DEFINE_ARRAY_STRUCT(double, Double, double)
+DEFINE_ARRAY_FUNCTIONS(double, Double, double)
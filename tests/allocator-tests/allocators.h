@@ -0,0 +1,13 @@
+#ifndef ARRAY_MACROS_ALLOCATORS_H
+#define ARRAY_MACROS_ALLOCATORS_H
+
+#include "allocator_macros.h"
+#include "array_macros.h"
+
+DECLARE_ARENA_ALLOCATOR(test, Test)
+DECLARE_POOL_ALLOCATOR(test, Test)
+
+DECLARE_ARRAY_STRUCT(double, Double)
+DECLARE_ARRAY_FUNCTIONS(double, Double, double)
+
+#endif // ARRAY_MACROS_ALLOCATORS_H
@@ -0,0 +1,85 @@
+/* Keep assert active in release builds. */
+#undef NDEBUG
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "allocators.h"
+
+static void test_arena(void) {
+    TestArena* arena = test_arena_create(256);
+    assert(arena != NULL);
+
+    const ArrayAllocator* allocator = test_arena_get_allocator(arena);
+
+    DoubleArray* a = double_array_create_with_allocator(2, allocator);
+    assert(a != NULL);
+    DoubleArray* b = double_array_create_with_allocator(2, allocator);
+    assert(b != NULL);
+
+    for (int i = 0; i < 100; i++) {
+        assert(double_array_push(a, i));
+        assert(double_array_push(b, -i));
+    }
+
+    for (size_t i = 0; i < 100; i++) {
+        double item = 0;
+        assert(double_array_get(a, i, &item));
+        assert(item == (double)i);
+        assert(double_array_get(b, i, &item));
+        assert(item == -(double)i);
+    }
+
+    double_array_free(a);
+
+    /* Tear down b with the arena instead of freeing it. */
+    test_arena_reset(arena);
+
+    DoubleArray* c = double_array_create_with_allocator(4, allocator);
+    assert(c != NULL);
+    assert(double_array_push(c, 1.5));
+
+    test_arena_free(arena);
+
+    /* A block size that would overflow with the block header is rejected. */
+    assert(test_arena_create(SIZE_MAX) == NULL);
+    assert(test_arena_create(SIZE_MAX - 1) == NULL);
+}
+
+static void test_pool(void) {
+    TestPool* pool = test_pool_create(128, 4);
+    assert(pool != NULL);
+    assert(test_pool_get_block_size(pool) >= 128);
+
+    const ArrayAllocator* allocator = test_pool_get_allocator(pool);
+
+    DoubleArray* a = double_array_create_with_allocator(8, allocator);
+    assert(a != NULL);
+
+    for (int i = 0; i < 16; i++) {
+        assert(double_array_push(a, i));
+    }
+    assert(!double_array_reserve(a, 1024));
+    assert(double_array_get_last_error(a) == ARRAY_ERROR_TYPE_ALLOCATION);
+
+    DoubleArray* b = double_array_create_with_allocator(8, allocator);
+    assert(b != NULL);
+    assert(double_array_create_with_allocator(8, allocator) == NULL);
+
+    double_array_free(b);
+    double_array_free(a);
+
+    test_pool_reset(pool);
+    test_pool_free(pool);
+}
+
+int main(void) {
+    printf("--- Running Allocator Tests ---\n");
+
+    test_arena();
+    test_pool();
+
+    printf("--- Allocator Tests Passed ---\n");
+
+    return 0;
+}
@@ -0,0 +1,10 @@
+#ifndef ARRAY_MACROS_INT_QUIET_ARRAY_H
+#define ARRAY_MACROS_INT_QUIET_ARRAY_H
+
+#include "array_macros.h"
+
+DECLARE_ARRAY_STRUCT(int, Int)
+DECLARE_ARRAY_FUNCTIONS(int, Int, int)
+DEFINE_ARRAY_UNCHECKED_FUNCTIONS(int, Int, int)
+
+#endif // ARRAY_MACROS_INT_QUIET_ARRAY_H
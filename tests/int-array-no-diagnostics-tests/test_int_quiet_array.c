@@ -0,0 +1,77 @@
+#define _POSIX_C_SOURCE 200809L
+
+/* Keep assert active in release builds. */
+#undef NDEBUG
+#include <assert.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "int_quiet_array.h"
+
+static void test_unchecked_access(void) {
+    IntArray* q = int_array_create(4);
+    assert(q != NULL);
+
+    for (int i = 0; i < 10; i++) {
+        assert(int_array_push(q, i));
+    }
+
+    IntArraySpan span = int_array_get_span(q);
+    assert(span.count == 10);
+    assert(span.data == int_array_get_data(q));
+
+    for (size_t i = 0; i < span.count; i++) {
+        int_array_span_set_unchecked(
+            span, i, int_array_span_get_unchecked(span, i) * 3);
+    }
+
+    for (size_t i = 0; i < int_array_get_count(q); i++) {
+        int item = 0;
+        assert(int_array_get(q, i, &item));
+        assert(item == (int)i * 3);
+    }
+
+    int_array_free(q);
+}
+
+static void test_silent_failures(void) {
+    IntArray* q = int_array_create(2);
+    assert(q != NULL);
+
+    /* Send stderr to a file to check that failures print nothing. */
+    fflush(stderr);
+    FILE* captured = tmpfile();
+    assert(captured != NULL);
+    const int saved = dup(STDERR_FILENO);
+    assert(saved >= 0);
+    assert(dup2(fileno(captured), STDERR_FILENO) >= 0);
+
+    int item = 0;
+    const bool got = int_array_get(q, 5, &item);
+    const bool removed = int_array_remove(q, 0);
+    IntArray* empty = int_array_create(0);
+
+    fflush(stderr);
+    assert(dup2(saved, STDERR_FILENO) >= 0);
+    close(saved);
+
+    assert(!got);
+    assert(!removed);
+    assert(empty == NULL);
+    assert(int_array_get_last_error(q) == ARRAY_ERROR_TYPE_EMPTY);
+    assert(ftell(captured) == 0);
+
+    fclose(captured);
+    int_array_free(q);
+}
+
+int main(void) {
+    printf("--- Running Integer Array No Diagnostics Tests ---\n");
+
+    test_unchecked_access();
+    test_silent_failures();
+
+    printf("--- Integer Array No Diagnostics Tests Passed ---\n");
+
+    return 0;
+}
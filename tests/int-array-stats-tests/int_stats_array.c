@@ -0,0 +1,6 @@
+#include "int_stats_array.h"
+
+#include "array_macros.h"
+
+DEFINE_ARRAY_STRUCT(int, Int, int)
+DEFINE_ARRAY_FUNCTIONS(int, Int, int)
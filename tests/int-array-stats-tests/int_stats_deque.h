@@ -0,0 +1,9 @@
+#ifndef ARRAY_MACROS_INT_STATS_DEQUE_H
+#define ARRAY_MACROS_INT_STATS_DEQUE_H
+
+#include "deque_macros.h"
+
+DECLARE_DEQUE_STRUCT(int, Int)
+DECLARE_DEQUE_FUNCTIONS(int, Int, int)
+
+#endif // ARRAY_MACROS_INT_STATS_DEQUE_H
@@ -0,0 +1,6 @@
+#include "int_stats_soa_array.h"
+
+#include "soa_array_macros.h"
+
+DEFINE_SOA_ARRAY_STRUCT(point, Point, POINT_FIELDS)
+DEFINE_SOA_ARRAY_FUNCTIONS(point, Point, POINT_FIELDS)
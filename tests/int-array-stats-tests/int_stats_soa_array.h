@@ -0,0 +1,16 @@
+#ifndef ARRAY_MACROS_INT_STATS_SOA_ARRAY_H
+#define ARRAY_MACROS_INT_STATS_SOA_ARRAY_H
+
+#include <stdint.h>
+
+#include "soa_array_macros.h"
+
+#define POINT_FIELDS(X) \
+    X(int, x)           \
+    X(int, y)           \
+    X(int64_t, tag)
+
+DECLARE_SOA_ARRAY_STRUCT(point, Point, POINT_FIELDS)
+DECLARE_SOA_ARRAY_FUNCTIONS(point, Point, POINT_FIELDS)
+
+#endif // ARRAY_MACROS_INT_STATS_SOA_ARRAY_H
@@ -0,0 +1,125 @@
+/* Keep assert active in release builds. */
+#undef NDEBUG
+#include <assert.h>
+#include <stdio.h>
+
+#include "int_stats_array.h"
+#include "int_stats_deque.h"
+#include "int_stats_soa_array.h"
+
+static void test_growth_counters(void) {
+    IntArray* q = int_array_create(2);
+    assert(q != NULL);
+
+    ArrayStats stats;
+    int_array_get_stats(q, &stats);
+    assert(stats.reallocs == 0);
+    assert(stats.peak_capacity == 2);
+
+    for (int i = 0; i < 10; i++) {
+        assert(int_array_push(q, i));
+    }
+
+    int_array_get_stats(q, &stats);
+    assert(stats.reallocs == 3);
+    assert(stats.peak_capacity == 16);
+    assert(stats.bytes_moved == 0);
+
+    /* Shrinking reallocates but leaves the peak alone. */
+    assert(int_array_shrink_to_fit(q));
+    int_array_get_stats(q, &stats);
+    assert(stats.reallocs == 4);
+    assert(stats.peak_capacity == 16);
+
+    int_array_free(q);
+}
+
+static void test_shift_counters(void) {
+    IntArray* q = int_array_create(16);
+    assert(q != NULL);
+
+    assert(int_array_push_n(q, (const int[]){1, 2, 3, 4}, 4));
+    assert(int_array_insert(q, 0, 0));
+    assert(int_array_remove(q, 1));
+    assert(int_array_remove_range(q, 0, 2));
+
+    ArrayStats stats;
+    int_array_get_stats(q, &stats);
+    assert(stats.bytes_moved == (4 + 3 + 2) * sizeof(int));
+    assert(stats.failed_ops == 0);
+
+    int item = 0;
+    assert(!int_array_get(q, 5, &item));
+    assert(!int_array_remove_range(q, 1, 5));
+    int_array_clear(q);
+    assert(!int_array_remove(q, 0));
+
+    int_array_get_stats(q, &stats);
+    assert(stats.failed_ops == 3);
+
+    int_array_free(q);
+}
+
+static void test_deque_counters(void) {
+    IntDeque* q = int_deque_create(2);
+    assert(q != NULL);
+
+    /* Filling from the front wraps, so each resize copies every element. */
+    for (int i = 0; i < 5; i++) {
+        assert(int_deque_push_front(q, i));
+    }
+    assert(!int_deque_set(q, 5, 0));
+
+    ArrayStats stats;
+    int_deque_get_stats(q, &stats);
+    assert(stats.reallocs == 2);
+    assert(stats.peak_capacity == 8);
+    assert(stats.bytes_moved == (2 + 4) * sizeof(int));
+    assert(stats.failed_ops == 1);
+
+    int_deque_free(q);
+}
+
+static void test_soa_counters(void) {
+    PointSoaArray* q = point_soa_array_create(2);
+    assert(q != NULL);
+
+    const size_t record_bytes = 2 * sizeof(int) + sizeof(int64_t);
+
+    for (int i = 0; i < 4; i++) {
+        assert(point_soa_array_push(q, (Point){i, i, i}));
+    }
+
+    /* Growing from 2 to 4 copies both records into the new block. */
+    ArrayStats stats;
+    point_soa_array_get_stats(q, &stats);
+    assert(stats.reallocs == 1);
+    assert(stats.bytes_moved == 2 * record_bytes);
+
+    /* Insert grows again (4 records copied), then shifts 3 records up. */
+    assert(point_soa_array_insert(q, 1, (Point){9, 9, 9}));
+    point_soa_array_get_stats(q, &stats);
+    assert(stats.reallocs == 2);
+    assert(stats.bytes_moved == (2 + 4 + 3) * record_bytes);
+
+    /* Removing index 0 of 5 shifts the other 4 down. */
+    assert(point_soa_array_remove(q, 0));
+    point_soa_array_get_stats(q, &stats);
+    assert(stats.bytes_moved == (2 + 4 + 3 + 4) * record_bytes);
+    assert(stats.failed_ops == 0);
+
+    point_soa_array_free(q);
+}
+
+int main(void) {
+    printf("--- Running Integer Array Stats Tests ---\n");
+
+    test_growth_counters();
+    test_shift_counters();
+    test_deque_counters();
+    test_soa_counters();
+
+    printf("--- Integer Array Stats Tests Passed ---\n");
+
+    return 0;
+}
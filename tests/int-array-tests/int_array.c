@@ -1,6 +1,12 @@
 #include "int_array.h"
 
+#include "array_io_macros.h"
 #include "array_macros.h"
+#include "array_numeric_macros.h"
+#include "array_sort_macros.h"
 
 DEFINE_ARRAY_STRUCT(int, Int, int)
 DEFINE_ARRAY_FUNCTIONS(int, Int, int)
+DEFINE_ARRAY_SORT(int, Int, int, (a > b) - (a < b))
+DEFINE_ARRAY_NUMERIC(int, Int, int)
+DEFINE_ARRAY_IO(int, Int, int)
@@ -1,9 +1,15 @@
 #ifndef ARRAY_MACROS_INT_ARRAY_H
 #define ARRAY_MACROS_INT_ARRAY_H
 
+#include "array_io_macros.h"
 #include "array_macros.h"
+#include "array_numeric_macros.h"
+#include "array_sort_macros.h"
 
 DECLARE_ARRAY_STRUCT(int, Int)
 DECLARE_ARRAY_FUNCTIONS(int, Int, int)
+DECLARE_ARRAY_SORT(int, Int, int)
+DECLARE_ARRAY_NUMERIC(int, Int, int)
+DECLARE_ARRAY_IO(int, Int, int)
 
 #endif // ARRAY_MACROS_INT_ARRAY_H
@@ -0,0 +1,11 @@
+#include "int_flat_array.h"
+
+#include "array_macros.h"
+
+DEFINE_ARRAY_STRUCT(int_flat, IntFlat, int)
+DEFINE_ARRAY_FUNCTIONS_EX(
+    int_flat,
+    IntFlat,
+    int,
+    ARRAY_LAYOUT_TYPE_SINGLE,
+    ARRAY_GROWTH_ONE_AND_HALF)
@@ -0,0 +1,9 @@
+#ifndef ARRAY_MACROS_INT_FLAT_ARRAY_H
+#define ARRAY_MACROS_INT_FLAT_ARRAY_H
+
+#include "array_macros.h"
+
+DECLARE_ARRAY_STRUCT(int_flat, IntFlat)
+DECLARE_ARRAY_FUNCTIONS(int_flat, IntFlat, int)
+
+#endif // ARRAY_MACROS_INT_FLAT_ARRAY_H
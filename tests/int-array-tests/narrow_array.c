@@ -0,0 +1,12 @@
+#include "narrow_array.h"
+
+#include "array_macros.h"
+#include "array_numeric_macros.h"
+
+DEFINE_ARRAY_STRUCT(char, Char, signed char)
+DEFINE_ARRAY_FUNCTIONS(char, Char, signed char)
+DEFINE_ARRAY_NUMERIC(char, Char, signed char)
+
+DEFINE_ARRAY_STRUCT(short, Short, short)
+DEFINE_ARRAY_FUNCTIONS(short, Short, short)
+DEFINE_ARRAY_NUMERIC(short, Short, short)
@@ -0,0 +1,15 @@
+#ifndef ARRAY_MACROS_NARROW_ARRAY_H
+#define ARRAY_MACROS_NARROW_ARRAY_H
+
+#include "array_macros.h"
+#include "array_numeric_macros.h"
+
+DECLARE_ARRAY_STRUCT(char, Char)
+DECLARE_ARRAY_FUNCTIONS(char, Char, signed char)
+DECLARE_ARRAY_NUMERIC(char, Char, signed char)
+
+DECLARE_ARRAY_STRUCT(short, Short)
+DECLARE_ARRAY_FUNCTIONS(short, Short, short)
+DECLARE_ARRAY_NUMERIC(short, Short, short)
+
+#endif // ARRAY_MACROS_NARROW_ARRAY_H
@@ -0,0 +1,16 @@
+#include "real_array.h"
+
+#include "array_macros.h"
+#include "array_numeric_macros.h"
+
+DEFINE_ARRAY_STRUCT(float, Float, float)
+DEFINE_ARRAY_FUNCTIONS(float, Float, float)
+DEFINE_ARRAY_NUMERIC(float, Float, float)
+
+DEFINE_ARRAY_STRUCT(double, Double, double)
+DEFINE_ARRAY_FUNCTIONS(double, Double, double)
+DEFINE_ARRAY_NUMERIC(double, Double, double)
+
+DEFINE_ARRAY_STRUCT(int64, Int64, int64_t)
+DEFINE_ARRAY_FUNCTIONS(int64, Int64, int64_t)
+DEFINE_ARRAY_NUMERIC(int64, Int64, int64_t)
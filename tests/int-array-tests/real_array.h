@@ -0,0 +1,21 @@
+#ifndef ARRAY_MACROS_REAL_ARRAY_H
+#define ARRAY_MACROS_REAL_ARRAY_H
+
+#include <stdint.h>
+
+#include "array_macros.h"
+#include "array_numeric_macros.h"
+
+DECLARE_ARRAY_STRUCT(float, Float)
+DECLARE_ARRAY_FUNCTIONS(float, Float, float)
+DECLARE_ARRAY_NUMERIC(float, Float, float)
+
+DECLARE_ARRAY_STRUCT(double, Double)
+DECLARE_ARRAY_FUNCTIONS(double, Double, double)
+DECLARE_ARRAY_NUMERIC(double, Double, double)
+
+DECLARE_ARRAY_STRUCT(int64, Int64)
+DECLARE_ARRAY_FUNCTIONS(int64, Int64, int64_t)
+DECLARE_ARRAY_NUMERIC(int64, Int64, int64_t)
+
+#endif // ARRAY_MACROS_REAL_ARRAY_H
@@ -1,7 +1,376 @@
+/* Keep assert active in release builds. */
+#undef NDEBUG
 #include <assert.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #include "int_array.h"
+#include "int_flat_array.h"
+#include "narrow_array.h"
+#include "real_array.h"
+
+static void assert_contents(IntArray* q, const int* expected, size_t count) {
+    assert(int_array_get_count(q) == count);
+    for (size_t i = 0; i < count; i++) {
+        int item = 0;
+        assert(int_array_get(q, i, &item));
+        assert(item == expected[i]);
+    }
+}
+
+static void test_range_operations(void) {
+    IntArray* q = int_array_create(1);
+    assert(q != NULL);
+
+    const int head[] = {1, 2, 6};
+    assert(int_array_push_n(q, head, 3));
+    assert(int_array_get_capacity(q) == 4);
+
+    const int middle[] = {3, 4, 5};
+    assert(int_array_insert_range(q, 2, middle, 3));
+    assert(!int_array_insert_range(q, 7, middle, 3));
+    assert_contents(q, (const int[]){1, 2, 3, 4, 5, 6}, 6);
+
+    assert(int_array_remove_range(q, 1, 3));
+    assert(!int_array_remove_range(q, 2, 2));
+    assert_contents(q, (const int[]){1, 5, 6}, 3);
+
+    assert(int_array_append_array(q, q));
+    assert_contents(q, (const int[]){1, 5, 6, 1, 5, 6}, 6);
+
+    assert(int_array_remove(q, 0));
+    assert_contents(q, (const int[]){5, 6, 1, 5, 6}, 5);
+
+    int_array_free(q);
+}
+
+static void test_self_aliasing(void) {
+    IntArray* q = int_array_create(1);
+    assert(q != NULL);
+
+    assert(int_array_push_n(q, (const int[]){1, 2, 3}, 3));
+    assert(int_array_shrink_to_fit(q));
+
+    /* Each call grows the array, so the source moves with the buffer */
+    assert(int_array_push_n(q, int_array_get_data(q), 3));
+    assert_contents(q, (const int[]){1, 2, 3, 1, 2, 3}, 6);
+
+    assert(int_array_shrink_to_fit(q));
+    assert(int_array_insert_range(q, 0, &int_array_get_data(q)[4], 2));
+    assert_contents(q, (const int[]){2, 3, 1, 2, 3, 1, 2, 3}, 8);
+
+    assert(int_array_shrink_to_fit(q));
+    assert(int_array_insert_range(q, 2, &int_array_get_data(q)[1], 3));
+    assert_contents(q, (const int[]){2, 3, 3, 1, 2, 1, 2, 3, 1, 2, 3}, 11);
+
+    assert(int_array_insert_range(q, 1, int_array_get_data(q), 1));
+    assert_contents(q, (const int[]){2, 2, 3, 3, 1, 2, 1, 2, 3, 1, 2, 3}, 12);
+
+    int_array_free(q);
+}
+
+static void test_data_access(void) {
+    IntArray* q = int_array_create(4);
+    assert(q != NULL);
+    assert(int_array_get_last_error(q) == ARRAY_ERROR_TYPE_NONE);
+
+    assert(int_array_push_n(q, (const int[]){1, 2, 3}, 3));
+
+    int* data = int_array_get_data_mut(q);
+    for (size_t i = 0; i < int_array_get_count(q); i++) {
+        data[i] *= 10;
+    }
+    assert(int_array_get_data(q) == data);
+    assert_contents(q, (const int[]){10, 20, 30}, 3);
+
+    int item = 0;
+    assert(!int_array_get(q, 3, &item));
+    assert(int_array_get_last_error(q) == ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);
+
+    int_array_clear(q);
+    assert(!int_array_remove(q, 0));
+    assert(int_array_get_last_error(q) == ARRAY_ERROR_TYPE_EMPTY);
+
+    int_array_free(q);
+}
+
+static void test_capacity_management(void) {
+    IntArray* q = int_array_create(2);
+    assert(q != NULL);
+
+    assert(int_array_reserve(q, 100));
+    assert(int_array_get_capacity(q) == 100);
+    assert(int_array_reserve(q, 10));
+    assert(int_array_get_capacity(q) == 100);
+
+    assert(int_array_push_n(q, (const int[]){1, 2, 3}, 3));
+    assert(int_array_shrink_to_fit(q));
+    assert(int_array_get_capacity(q) == 3);
+    assert_contents(q, (const int[]){1, 2, 3}, 3);
+
+    int_array_free(q);
+}
+
+static void test_single_allocation(void) {
+    IntFlatArray* q = int_flat_array_create(2);
+    assert(q != NULL);
+    const int* inline_data = int_flat_array_get_data(q);
+
+    for (int i = 0; i < 10; i++) {
+        assert(int_flat_array_push(q, i));
+    }
+    assert(int_flat_array_get_capacity(q) == 11);
+    assert(int_flat_array_get_data(q) != inline_data);
+
+    /* Too big for the inline block, so it stays in the spilled buffer */
+    assert(int_flat_array_remove_range(q, 3, 4));
+    assert(int_flat_array_shrink_to_fit(q));
+    assert(int_flat_array_get_capacity(q) == 6);
+    assert(int_flat_array_get_data(q) != inline_data);
+
+    assert(int_flat_array_remove_range(q, 2, 4));
+    assert(int_flat_array_shrink_to_fit(q));
+    assert(int_flat_array_get_capacity(q) == 2);
+    assert(int_flat_array_get_data(q) == inline_data);
+
+    int item = 0;
+    assert(int_flat_array_get(q, 1, &item));
+    assert(item == 1);
+
+    assert(int_flat_array_push(q, 2));
+    assert(int_flat_array_get_data(q) != inline_data);
+    assert(int_flat_array_get(q, 2, &item));
+    assert(item == 2);
+
+    int_flat_array_free(q);
+}
+
+static void test_sorting(void) {
+    IntArray* q = int_array_create(8);
+    assert(q != NULL);
+
+    unsigned int seed = 12345;
+    for (int i = 0; i < 1000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        assert(int_array_push(q, (int)(seed >> 16) % 100));
+    }
+
+    int_array_sort(q);
+
+    const int* data = int_array_get_data(q);
+    for (size_t i = 1; i < int_array_get_count(q); i++) {
+        assert(data[i - 1] <= data[i]);
+    }
+
+    size_t index = 0;
+    assert(int_array_binary_search(q, data[500], &index));
+    assert(data[index] == data[500]);
+    assert(!int_array_binary_search(q, 100, &index));
+
+    const size_t lower = int_array_lower_bound(q, 50);
+    const size_t upper = int_array_upper_bound(q, 50);
+    assert(lower <= upper);
+    assert(lower == 0 || data[lower - 1] < 50);
+    assert(upper == int_array_get_count(q) || data[upper] > 50);
+
+    int_array_clear(q);
+    const int items[] = {5, 1, 4, 1, 3};
+    for (size_t i = 0; i < 5; i++) {
+        assert(int_array_insert_sorted(q, items[i]));
+    }
+    assert_contents(q, (const int[]){1, 1, 3, 4, 5}, 5);
+
+    int_array_free(q);
+}
+
+static void test_numeric_kernels(void) {
+    IntArray* q = int_array_create(8);
+    IntArray* ones = int_array_create(8);
+    assert(q != NULL && ones != NULL);
+
+    int item = 0;
+    assert(!int_array_min(q, &item));
+    assert(int_array_get_last_error(q) == ARRAY_ERROR_TYPE_EMPTY);
+    assert(!int_array_max(ones, &item));
+    assert(int_array_get_last_error(ones) == ARRAY_ERROR_TYPE_EMPTY);
+
+    /* 37 items cover full vectors and a scalar tail at any width. */
+    for (int i = 0; i < 37; i++) {
+        assert(int_array_push(q, (i * 7) % 37 - 18));
+        assert(int_array_push(ones, 1));
+    }
+
+    size_t index = 0;
+    assert(int_array_find(q, 4, &index));
+    assert(index == 19);
+    assert(!int_array_find(q, 100, &index));
+    assert(int_array_count_of(q, 4) == 1);
+
+    assert(int_array_min(q, &item));
+    assert(item == -18);
+    assert(int_array_max(q, &item));
+    assert(item == 18);
+    assert(int_array_sum(q) == 0);
+
+    assert(int_array_add(q, ones));
+    int_array_scale(q, 2);
+    assert(int_array_sum(q) == 74);
+
+    int_array_fill(q, 3);
+    assert(int_array_count_of(q, 3) == 37);
+
+    int_array_free(ones);
+    int_array_free(q);
+}
+
+/*
+ * Runs every kernel over 37 multiples of step, which are exact in each
+ * type, so float and double sums can be compared exactly.
+ */
+#define CHECK_NUMERIC_KERNELS(prefix, name, type, step)                       \
+    do {                                                                      \
+        name##Array* q = prefix##_array_create(8);                            \
+        name##Array* ones = prefix##_array_create(8);                         \
+        assert(q != NULL && ones != NULL);                                    \
+                                                                              \
+        for (int i = 0; i < 37; i++) {                                        \
+            assert(prefix##_array_push(q, (type)((i * 7) % 37 - 18) * step)); \
+            assert(prefix##_array_push(ones, step));                          \
+        }                                                                     \
+                                                                              \
+        size_t index = 0;                                                     \
+        assert(prefix##_array_find(q, 4 * step, &index));                     \
+        assert(index == 19);                                                  \
+        assert(!prefix##_array_find(q, 100 * step, &index));                  \
+        assert(prefix##_array_count_of(q, 4 * step) == 1);                    \
+                                                                              \
+        type item = 0;                                                        \
+        assert(prefix##_array_min(q, &item));                                 \
+        assert(item == -18 * step);                                           \
+        assert(prefix##_array_max(q, &item));                                 \
+        assert(item == 18 * step);                                            \
+        assert(prefix##_array_sum(q) == 0);                                   \
+                                                                              \
+        assert(prefix##_array_add(q, ones));                                  \
+        prefix##_array_scale(q, 2);                                           \
+        assert(prefix##_array_sum(q) == 74 * step);                           \
+        assert(prefix##_array_max(q, &item));                                 \
+        assert(item == 38 * step);                                            \
+                                                                              \
+        assert(prefix##_array_remove(ones, 0));                               \
+        assert(!prefix##_array_add(q, ones));                                 \
+        assert(prefix##_array_get_last_error(q)                               \
+               == ARRAY_ERROR_TYPE_SIZE_MISMATCH);                            \
+                                                                              \
+        prefix##_array_free(ones);                                            \
+        prefix##_array_free(q);                                               \
+    } while (0)
+
+static void test_wide_numeric_kernels(void) {
+    CHECK_NUMERIC_KERNELS(float, Float, float, 0.5f);
+    CHECK_NUMERIC_KERNELS(double, Double, double, 0.25);
+    /* A step above 2^32 catches kernels that truncate 64-bit lanes. */
+    CHECK_NUMERIC_KERNELS(int64, Int64, int64_t, ((int64_t)1 << 33));
+}
+
+/* Narrow lanes must be flushed before their counters wrap. */
+static void test_narrow_count_of(void) {
+    CharArray* chars = char_array_create(16);
+    ShortArray* shorts = short_array_create(16);
+    assert(chars != NULL && shorts != NULL);
+
+    for (int i = 0; i < 10000; i++) {
+        assert(char_array_push(chars, 7));
+    }
+    assert(char_array_push(chars, 1));
+    assert(char_array_count_of(chars, 7) == 10000);
+
+    for (int i = 0; i < 1000000; i++) {
+        assert(short_array_push(shorts, -3));
+    }
+    assert(short_array_push(shorts, 1));
+    assert(short_array_count_of(shorts, -3) == 1000000);
+
+    short_array_free(shorts);
+    char_array_free(chars);
+}
+
+static void test_save_and_load(void) {
+    IntArray* q = int_array_create(4);
+    IntArray* loaded = int_array_create(1);
+    assert(q != NULL && loaded != NULL);
+
+    for (int i = 0; i < 100; i++) {
+        assert(int_array_push(q, i * i));
+    }
+
+    FILE* file = tmpfile();
+    assert(file != NULL);
+    assert(int_array_save(q, file));
+
+    rewind(file);
+    assert(int_array_push(loaded, -1));
+    assert(int_array_load(loaded, file));
+    assert(int_array_get_count(loaded) == 100);
+    for (size_t i = 0; i < 100; i++) {
+        int item = 0;
+        assert(int_array_get(loaded, i, &item));
+        assert(item == (int)(i * i));
+    }
+
+    /* Loading into an array that already has room copies in place. */
+    const int* data = int_array_get_data(loaded);
+    rewind(file);
+    assert(int_array_load(loaded, file));
+    assert(int_array_get_data(loaded) == data);
+    assert(int_array_get_count(loaded) == 100);
+
+    /* A stream cut short inside the data is rejected. */
+    FILE* truncated = tmpfile();
+    assert(truncated != NULL);
+    rewind(file);
+    char bytes[64];
+    assert(fread(bytes, 1, sizeof(bytes), file) == sizeof(bytes));
+    assert(fwrite(bytes, 1, sizeof(bytes), truncated) == sizeof(bytes));
+    rewind(truncated);
+    const size_t capacity = int_array_get_capacity(loaded);
+    assert(!int_array_load(loaded, truncated));
+    assert(int_array_get_last_error(loaded) == ARRAY_ERROR_TYPE_IO);
+
+    /* A failed load keeps the old contents. */
+    assert(int_array_get_count(loaded) == 100);
+    assert(int_array_get_capacity(loaded) == capacity);
+    for (size_t i = 0; i < 100; i++) {
+        int item = 0;
+        assert(int_array_get(loaded, i, &item));
+        assert(item == (int)(i * i));
+    }
+
+    /* A header claiming more items than follow does not reserve them all. */
+    FILE* oversized = tmpfile();
+    assert(oversized != NULL);
+    const uint32_t version = 1;
+    const uint32_t element_size = sizeof(int);
+    const uint64_t count = SIZE_MAX / sizeof(int);
+    const uint64_t data_offset = 32;
+    assert(fwrite("ARRMACRO", 1, 8, oversized) == 8);
+    assert(fwrite(&version, sizeof(version), 1, oversized) == 1);
+    assert(fwrite(&element_size, sizeof(element_size), 1, oversized) == 1);
+    assert(fwrite(&count, sizeof(count), 1, oversized) == 1);
+    assert(fwrite(&data_offset, sizeof(data_offset), 1, oversized) == 1);
+    assert(fwrite((const int[]){1, 2, 3}, sizeof(int), 3, oversized) == 3);
+    rewind(oversized);
+    assert(!int_array_load(loaded, oversized));
+    assert(int_array_get_last_error(loaded) == ARRAY_ERROR_TYPE_IO);
+    assert(int_array_get_count(loaded) == 100);
+    assert(int_array_get_capacity(loaded) == capacity);
+
+    fclose(oversized);
+    fclose(truncated);
+    fclose(file);
+    int_array_free(loaded);
+    int_array_free(q);
+}
 
 int main(void) {
     printf("--- Running Integer Array Tests ---\n");
@@ -11,6 +380,17 @@ int main(void) {
 
     int_array_free(q);
 
+    test_range_operations();
+    test_self_aliasing();
+    test_data_access();
+    test_capacity_management();
+    test_single_allocation();
+    test_sorting();
+    test_numeric_kernels();
+    test_wide_numeric_kernels();
+    test_narrow_count_of();
+    test_save_and_load();
+
     printf("--- Integer Array Tests Passed ---\n");
 
     return 0;
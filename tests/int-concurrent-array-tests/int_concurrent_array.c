@@ -0,0 +1,6 @@
+#include "int_concurrent_array.h"
+
+#include "concurrent_array_macros.h"
+
+DEFINE_CONCURRENT_ARRAY_STRUCT(int, Int, int)
+DEFINE_CONCURRENT_ARRAY_FUNCTIONS(int, Int, int)
@@ -0,0 +1,9 @@
+#ifndef ARRAY_MACROS_INT_CONCURRENT_ARRAY_H
+#define ARRAY_MACROS_INT_CONCURRENT_ARRAY_H
+
+#include "concurrent_array_macros.h"
+
+DECLARE_CONCURRENT_ARRAY_STRUCT(int, Int)
+DECLARE_CONCURRENT_ARRAY_FUNCTIONS(int, Int, int)
+
+#endif // ARRAY_MACROS_INT_CONCURRENT_ARRAY_H
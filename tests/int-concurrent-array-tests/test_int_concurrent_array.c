@@ -0,0 +1,115 @@
+/* Keep assert active in release builds. */
+#undef NDEBUG
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "int_concurrent_array.h"
+
+#define PRODUCER_COUNT 8
+#define PUSHES_PER_PRODUCER 50000
+
+/* Each item encodes its producer in the high bits and a sequence below. */
+#define ITEM_SHIFT 20
+
+static IntConcurrentArray* shared;
+static atomic_bool producers_done;
+
+static void* produce(void* arg) {
+    const int producer = (int)(size_t)arg;
+
+    for (int i = 0; i < PUSHES_PER_PRODUCER; i++) {
+        bool pushed = int_concurrent_array_push(
+            shared, (producer << ITEM_SHIFT) | i);
+        assert(pushed);
+        (void)pushed;
+    }
+
+    return NULL;
+}
+
+static void* read_published(void* arg) {
+    (void)arg;
+    size_t seen = 0;
+
+    while (!atomic_load(&producers_done)) {
+        const size_t count = int_concurrent_array_get_count(shared);
+        assert(count >= seen);
+
+        /* Every published item must already hold a producer's value. */
+        for (size_t i = seen; i < count; i++) {
+            int item = -1;
+            assert(int_concurrent_array_get(shared, i, &item));
+            assert((item >> ITEM_SHIFT) < PRODUCER_COUNT);
+            assert((item & ((1 << ITEM_SHIFT) - 1)) < PUSHES_PER_PRODUCER);
+        }
+
+        seen = count;
+    }
+
+    return NULL;
+}
+
+static void test_concurrent_push(void) {
+    shared = int_concurrent_array_create(16);
+    assert(shared != NULL);
+
+    pthread_t reader;
+    pthread_t producers[PRODUCER_COUNT];
+
+    assert(pthread_create(&reader, NULL, read_published, NULL) == 0);
+    for (size_t i = 0; i < PRODUCER_COUNT; i++) {
+        assert(pthread_create(&producers[i], NULL, produce, (void*)i) == 0);
+    }
+    for (size_t i = 0; i < PRODUCER_COUNT; i++) {
+        assert(pthread_join(producers[i], NULL) == 0);
+    }
+    atomic_store(&producers_done, true);
+    assert(pthread_join(reader, NULL) == 0);
+
+    const size_t total = (size_t)PRODUCER_COUNT * PUSHES_PER_PRODUCER;
+    assert(int_concurrent_array_get_count(shared) == total);
+
+    /* Each producer's items appear exactly once and in push order. */
+    int next[PRODUCER_COUNT] = {0};
+    for (size_t i = 0; i < total; i++) {
+        int item = -1;
+        assert(int_concurrent_array_get(shared, i, &item));
+        const int producer = item >> ITEM_SHIFT;
+        assert(producer >= 0 && producer < PRODUCER_COUNT);
+        assert((item & ((1 << ITEM_SHIFT) - 1)) == next[producer]);
+        next[producer]++;
+    }
+
+    int_concurrent_array_free(shared);
+}
+
+static void test_stable_pointers(void) {
+    IntConcurrentArray* q = int_concurrent_array_create(1);
+    assert(q != NULL);
+
+    assert(int_concurrent_array_push(q, 7));
+    const int* first = int_concurrent_array_get_ptr(q, 0);
+    for (int i = 0; i < 1000; i++) {
+        assert(int_concurrent_array_push(q, i));
+    }
+    assert(int_concurrent_array_get_ptr(q, 0) == first);
+    assert(*first == 7);
+    assert(int_concurrent_array_get_ptr(q, 1001) == NULL);
+
+    int_concurrent_array_free(q);
+}
+
+int main(void) {
+    printf("--- Running Integer Concurrent Array Tests ---\n");
+
+    test_concurrent_push();
+    test_stable_pointers();
+
+    printf("--- Integer Concurrent Array Tests Passed ---\n");
+
+    return 0;
+}
@@ -0,0 +1,6 @@
+#include "int_deque.h"
+
+#include "deque_macros.h"
+
+DEFINE_DEQUE_STRUCT(int, Int, int)
+DEFINE_DEQUE_FUNCTIONS(int, Int, int)
@@ -0,0 +1,87 @@
+/* Keep assert active in release builds. */
+#undef NDEBUG
+#include <assert.h>
+#include <stdio.h>
+
+#include "int_deque.h"
+
+static void test_queue_order(void) {
+    IntDeque* q = int_deque_create(4);
+    assert(q != NULL);
+
+    /* Advance head so that later pushes wrap around the buffer. */
+    for (int i = 0; i < 3; i++) {
+        assert(int_deque_push_back(q, i));
+        assert(int_deque_pop_front(q, NULL));
+    }
+
+    for (int i = 0; i < 10; i++) {
+        assert(int_deque_push_back(q, i));
+    }
+    assert(int_deque_get_count(q) == 10);
+    assert(int_deque_get_capacity(q) == 16);
+
+    for (int i = 0; i < 10; i++) {
+        int item = -1;
+        assert(int_deque_pop_front(q, &item));
+        assert(item == i);
+    }
+    assert(int_deque_is_empty(q));
+    assert(!int_deque_pop_front(q, NULL));
+    assert(int_deque_get_last_error(q) == ARRAY_ERROR_TYPE_EMPTY);
+
+    /* Indexing an empty deque reports EMPTY, as the array does. */
+    int item = -1;
+    assert(!int_deque_get(q, 0, &item));
+    assert(int_deque_get_last_error(q) == ARRAY_ERROR_TYPE_EMPTY);
+    assert(!int_deque_set(q, 0, 1));
+    assert(int_deque_get_last_error(q) == ARRAY_ERROR_TYPE_EMPTY);
+
+    int_deque_free(q);
+}
+
+static void test_both_ends(void) {
+    IntDeque* q = int_deque_create(2);
+    assert(q != NULL);
+
+    assert(int_deque_push_back(q, 2));
+    assert(int_deque_push_front(q, 1));
+    assert(int_deque_push_front(q, 0));
+    assert(int_deque_push_back(q, 3));
+    assert(int_deque_is_full(q));
+
+    for (size_t i = 0; i < 4; i++) {
+        int item = -1;
+        assert(int_deque_get(q, i, &item));
+        assert(item == (int)i);
+    }
+
+    assert(int_deque_set(q, 3, 30));
+    assert(!int_deque_set(q, 4, 40));
+    assert(int_deque_get_last_error(q) == ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);
+
+    int item = -1;
+    assert(int_deque_pop_back(q, &item));
+    assert(item == 30);
+    assert(int_deque_pop_front(q, &item));
+    assert(item == 0);
+    assert(int_deque_get_count(q) == 2);
+
+    assert(int_deque_reserve(q, 64));
+    assert(int_deque_get_capacity(q) == 64);
+    assert(int_deque_get(q, 1, &item));
+    assert(item == 2);
+
+    int_deque_free(q);
+}
+
+int main(void) {
+    printf("--- Running Integer Deque Tests ---\n");
+
+    test_queue_order();
+    test_both_ends();
+
+    printf("--- Integer Deque Tests Passed ---\n");
+
+    return 0;
+}
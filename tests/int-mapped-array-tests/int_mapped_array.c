@@ -0,0 +1,12 @@
+#include "int_mapped_array.h"
+
+#include "array_io_macros.h"
+#include "array_macros.h"
+#include "mapped_array_macros.h"
+
+DEFINE_MAPPED_ARRAY_STRUCT(int, Int, int)
+DEFINE_MAPPED_ARRAY_FUNCTIONS(int, Int, int)
+
+DEFINE_ARRAY_STRUCT(int, Int, int)
+DEFINE_ARRAY_FUNCTIONS(int, Int, int)
+DEFINE_ARRAY_IO(int, Int, int)
@@ -0,0 +1,15 @@
+#ifndef ARRAY_MACROS_INT_MAPPED_ARRAY_H
+#define ARRAY_MACROS_INT_MAPPED_ARRAY_H
+
+#include "array_io_macros.h"
+#include "array_macros.h"
+#include "mapped_array_macros.h"
+
+DECLARE_MAPPED_ARRAY_STRUCT(int, Int)
+DECLARE_MAPPED_ARRAY_FUNCTIONS(int, Int, int)
+
+DECLARE_ARRAY_STRUCT(int, Int)
+DECLARE_ARRAY_FUNCTIONS(int, Int, int)
+DECLARE_ARRAY_IO(int, Int, int)
+
+#endif // ARRAY_MACROS_INT_MAPPED_ARRAY_H
@@ -0,0 +1,134 @@
+/* Keep assert active in release builds. */
+#undef NDEBUG
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "int_mapped_array.h"
+
+static void make_path(char* path) {
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+    unlink(path);
+}
+
+static void test_push_and_reopen(void) {
+    char path[] = "/tmp/int-mapped-array-XXXXXX";
+    make_path(path);
+
+    IntMappedArray* q = int_mapped_array_open(path, 2);
+    assert(q != NULL);
+    assert(int_mapped_array_get_capacity(q) == 2);
+
+    /* Growing remaps the file several times. */
+    for (int i = 0; i < 1000; i++) {
+        assert(int_mapped_array_push(q, i * 3));
+    }
+    assert(int_mapped_array_get_capacity(q) == 1024);
+    assert(int_mapped_array_set(q, 0, -7));
+    assert(int_mapped_array_sync(q));
+    int_mapped_array_close(q);
+
+    /* Reopening maps the same elements back without reading them. */
+    q = int_mapped_array_open(path, 1);
+    assert(q != NULL);
+    assert(int_mapped_array_get_count(q) == 1000);
+    assert(int_mapped_array_get_capacity(q) == 1024);
+
+    const int* data = int_mapped_array_get_data(q);
+    assert(data[0] == -7);
+    for (int i = 1; i < 1000; i++) {
+        assert(data[i] == i * 3);
+    }
+
+    int item = 0;
+    assert(int_mapped_array_pop(q, &item));
+    assert(item == 999 * 3);
+    assert(!int_mapped_array_get(q, 999, &item));
+    assert(int_mapped_array_get_last_error(q) == ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);
+
+    assert(int_mapped_array_reserve(q, 5000));
+    assert(int_mapped_array_get_capacity(q) == 5000);
+    int_mapped_array_close(q);
+
+    /* The file shares the save format, so a plain array can load it. */
+    FILE* file = fopen(path, "rb");
+    assert(file != NULL);
+    IntArray* loaded = int_array_create(1);
+    assert(loaded != NULL);
+    assert(int_array_load(loaded, file));
+    assert(int_array_get_count(loaded) == 999);
+    assert(int_array_get(loaded, 998, &item));
+    assert(item == 998 * 3);
+    int_array_free(loaded);
+    fclose(file);
+
+    q = int_mapped_array_open(path, 1);
+    assert(q != NULL);
+    int_mapped_array_clear(q);
+    assert(!int_mapped_array_pop(q, NULL));
+    assert(int_mapped_array_get_last_error(q) == ARRAY_ERROR_TYPE_EMPTY);
+    int_mapped_array_close(q);
+
+    unlink(path);
+}
+
+static void test_zero_capacity(void) {
+    char path[] = "/tmp/int-mapped-array-XXXXXX";
+    make_path(path);
+
+    IntMappedArray* q = int_mapped_array_open(path, 4);
+    assert(q != NULL);
+    int_mapped_array_close(q);
+
+    /* Cut the file back to its header, leaving no room for elements. */
+    assert(truncate(path, ARRAY_MAPPED_DATA_OFFSET) == 0);
+
+    q = int_mapped_array_open(path, 4);
+    assert(q != NULL);
+    assert(int_mapped_array_get_capacity(q) == 0);
+
+    for (int i = 0; i < 3; i++) {
+        assert(int_mapped_array_push(q, i));
+    }
+    assert(int_mapped_array_get_capacity(q) == 4);
+    assert(int_mapped_array_get_count(q) == 3);
+
+    int item = 0;
+    assert(int_mapped_array_get(q, 2, &item));
+    assert(item == 2);
+    int_mapped_array_close(q);
+
+    unlink(path);
+}
+
+static void test_invalid_file(void) {
+    char path[] = "/tmp/int-mapped-array-XXXXXX";
+    make_path(path);
+
+    FILE* file = fopen(path, "wb");
+    assert(file != NULL);
+    for (int i = 0; i < 100; i++) {
+        fputc('x', file);
+    }
+    fclose(file);
+
+    assert(int_mapped_array_open(path, 4) == NULL);
+    assert(int_mapped_array_open(path, 0) == NULL);
+
+    unlink(path);
+}
+
+int main(void) {
+    printf("--- Running Integer Mapped Array Tests ---\n");
+
+    test_push_and_reopen();
+    test_zero_capacity();
+    test_invalid_file();
+
+    printf("--- Integer Mapped Array Tests Passed ---\n");
+
+    return 0;
+}
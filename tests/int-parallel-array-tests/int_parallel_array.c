@@ -0,0 +1,8 @@
+#include "int_parallel_array.h"
+
+#include "array_macros.h"
+#include "array_parallel_macros.h"
+
+DEFINE_ARRAY_STRUCT(int, Int, int)
+DEFINE_ARRAY_FUNCTIONS(int, Int, int)
+DEFINE_ARRAY_PARALLEL(int, Int, int)
@@ -0,0 +1,11 @@
+#ifndef ARRAY_MACROS_INT_PARALLEL_ARRAY_H
+#define ARRAY_MACROS_INT_PARALLEL_ARRAY_H
+
+#include "array_macros.h"
+#include "array_parallel_macros.h"
+
+DECLARE_ARRAY_STRUCT(int, Int)
+DECLARE_ARRAY_FUNCTIONS(int, Int, int)
+DECLARE_ARRAY_PARALLEL(int, Int, int)
+
+#endif // ARRAY_MACROS_INT_PARALLEL_ARRAY_H
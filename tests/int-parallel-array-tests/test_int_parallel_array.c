@@ -0,0 +1,173 @@
+/* Keep assert active in release builds. */
+#undef NDEBUG
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "int_parallel_array.h"
+
+/* Large enough to split into many chunks on any pool. */
+#define ITEM_COUNT 100000
+
+static IntArray* create_sequence(void) {
+    IntArray* q = int_array_create(ITEM_COUNT);
+    assert(q != NULL);
+
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        assert(int_array_push(q, i));
+    }
+
+    return q;
+}
+
+static void add_offset(int* item, void* context) {
+    *item += *(const int*)context;
+}
+
+static int square_mod(int item, void* context) {
+    (void)context;
+    return (item % 100) * (item % 100);
+}
+
+static int add(int accumulator, int item, void* context) {
+    (void)context;
+    return accumulator + item;
+}
+
+/* Associative but not commutative, so the combine order is checked. */
+static int keep_first(int accumulator, int item, void* context) {
+    const int none = *(const int*)context;
+    return accumulator == none ? item : accumulator;
+}
+
+static bool is_multiple_of_three(int item, void* context) {
+    (void)context;
+    return item % 3 == 0;
+}
+
+/* Fails every allocation once *context is set. */
+static void* failing_allocate(void* context, size_t size) {
+    return *(const bool*)context ? NULL : malloc(size);
+}
+
+static void* failing_reallocate(
+    void* context, void* ptr, size_t old_size, size_t new_size) {
+    (void)old_size;
+    return *(const bool*)context ? NULL : realloc(ptr, new_size);
+}
+
+static void failing_deallocate(void* context, void* ptr) {
+    (void)context;
+    free(ptr);
+}
+
+static void run_passes(ArrayThreadPool* pool) {
+    IntArray* q = create_sequence();
+    IntArray* squares = int_array_create(1);
+    assert(squares != NULL);
+
+    const int offset = 1;
+    int_array_parallel_for_each(q, pool, add_offset, (void*)&offset);
+    const int* data = int_array_get_data(q);
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        assert(data[i] == i + 1);
+    }
+
+    assert(int_array_parallel_map(q, squares, pool, square_mod, NULL));
+    assert(int_array_get_count(squares) == ITEM_COUNT);
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        int item = 0;
+        assert(int_array_get(squares, (size_t)i, &item));
+        assert(item == ((i + 1) % 100) * ((i + 1) % 100));
+    }
+
+    int result = 0;
+    assert(int_array_parallel_reduce(squares, pool, 0, add, NULL, &result));
+    assert(result == 1000 * 328350);
+
+    const int none = -1;
+    assert(int_array_parallel_reduce(
+        q, pool, none, keep_first, (void*)&none, &result));
+    assert(result == 1);
+
+    assert(int_array_parallel_filter(q, pool, is_multiple_of_three, NULL));
+    assert(int_array_get_count(q) == ITEM_COUNT / 3);
+    data = int_array_get_data(q);
+    for (size_t i = 0; i < int_array_get_count(q); i++) {
+        assert(data[i] == 3 * ((int)i + 1));
+    }
+
+    /* Mapping in place reuses the source storage. */
+    assert(int_array_parallel_map(q, q, pool, square_mod, NULL));
+    assert(int_array_get_count(q) == ITEM_COUNT / 3);
+    assert(data[0] == 9);
+
+    int_array_clear(q);
+    result = -1;
+    assert(int_array_parallel_reduce(q, pool, 0, add, NULL, &result));
+    assert(result == 0);
+    assert(int_array_parallel_filter(q, pool, is_multiple_of_three, NULL));
+
+    int_array_free(squares);
+    int_array_free(q);
+}
+
+static void test_reduce_allocation_failure(void) {
+    bool fail = false;
+    const ArrayAllocator allocator = {
+        failing_allocate, failing_reallocate, failing_deallocate, &fail};
+    IntArray* q = int_array_create_with_allocator(ITEM_COUNT, &allocator);
+    assert(q != NULL);
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        assert(int_array_push(q, i));
+    }
+
+    fail = true;
+    int result = -1;
+    assert(!int_array_parallel_reduce(q, NULL, 0, add, NULL, &result));
+    assert(int_array_get_last_error(q) == ARRAY_ERROR_TYPE_ALLOCATION);
+    assert(result == -1);
+
+    int_array_free(q);
+}
+
+static void test_thread_pool(void) {
+    ArrayThreadPool* pool = array_thread_pool_create(4);
+    assert(pool != NULL);
+    assert(array_thread_pool_get_thread_count(pool) == 4);
+
+    /* The same pool runs many passes in a row. */
+    for (int i = 0; i < 3; i++) {
+        run_passes(pool);
+    }
+
+    array_thread_pool_free(pool);
+}
+
+static void test_default_thread_count(void) {
+    ArrayThreadPool* pool = array_thread_pool_create(0);
+    assert(pool != NULL);
+    assert(array_thread_pool_get_thread_count(pool) >= 1);
+
+    run_passes(pool);
+
+    array_thread_pool_free(pool);
+}
+
+static void test_calling_thread_only(void) {
+    run_passes(NULL);
+}
+
+int main(void) {
+    printf("--- Running Integer Parallel Array Tests ---\n");
+
+    test_thread_pool();
+    test_default_thread_count();
+    test_calling_thread_only();
+    test_reduce_allocation_failure();
+
+    printf("--- Integer Parallel Array Tests Passed ---\n");
+
+    return 0;
+}
@@ -0,0 +1,6 @@
+#include "int_segmented_array.h"
+
+#include "segmented_array_macros.h"
+
+DEFINE_SEGMENTED_ARRAY_STRUCT(int, Int, int)
+DEFINE_SEGMENTED_ARRAY_FUNCTIONS(int, Int, int)
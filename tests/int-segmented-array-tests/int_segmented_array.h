@@ -0,0 +1,9 @@
+#ifndef ARRAY_MACROS_INT_SEGMENTED_ARRAY_H
+#define ARRAY_MACROS_INT_SEGMENTED_ARRAY_H
+
+#include "segmented_array_macros.h"
+
+DECLARE_SEGMENTED_ARRAY_STRUCT(int, Int)
+DECLARE_SEGMENTED_ARRAY_FUNCTIONS(int, Int, int)
+
+#endif // ARRAY_MACROS_INT_SEGMENTED_ARRAY_H
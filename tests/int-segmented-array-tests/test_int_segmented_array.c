@@ -0,0 +1,72 @@
+/* Keep assert active in release builds. */
+#undef NDEBUG
+#include <assert.h>
+#include <stdio.h>
+
+#include "int_segmented_array.h"
+
+static void test_push_and_index(void) {
+    IntSegmentedArray* q = int_segmented_array_create(3);
+    assert(q != NULL);
+    assert(int_segmented_array_get_capacity(q) == 4);
+
+    for (int i = 0; i < 1000; i++) {
+        assert(int_segmented_array_push(q, i));
+    }
+    assert(int_segmented_array_get_count(q) == 1000);
+    assert(int_segmented_array_get_capacity(q) == 1020);
+
+    for (size_t i = 0; i < 1000; i++) {
+        int item = -1;
+        assert(int_segmented_array_get(q, i, &item));
+        assert(item == (int)i);
+    }
+    assert(!int_segmented_array_get(q, 1000, NULL));
+    assert(int_segmented_array_get_last_error(q)
+           == ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);
+
+    assert(int_segmented_array_set(q, 999, -1));
+    int item = 0;
+    assert(int_segmented_array_pop(q, &item));
+    assert(item == -1);
+
+    int_segmented_array_free(q);
+}
+
+static void test_stable_addresses(void) {
+    IntSegmentedArray* q = int_segmented_array_create(1);
+    assert(q != NULL);
+
+    assert(int_segmented_array_push(q, 42));
+    const int* first = int_segmented_array_get_ptr(q, 0);
+    assert(first != NULL);
+
+    for (int i = 0; i < 10000; i++) {
+        assert(int_segmented_array_push(q, i));
+    }
+
+    assert(int_segmented_array_get_ptr(q, 0) == first);
+    assert(*first == 42);
+
+    int* last = int_segmented_array_get_ptr_mut(q, 10000);
+    assert(last != NULL && *last == 9999);
+    assert(int_segmented_array_get_ptr(q, 10001) == NULL);
+
+    int_segmented_array_clear(q);
+    assert(int_segmented_array_is_empty(q));
+    assert(int_segmented_array_reserve(q, 100000));
+    assert(int_segmented_array_get_capacity(q) >= 100000);
+
+    int_segmented_array_free(q);
+}
+
+int main(void) {
+    printf("--- Running Integer Segmented Array Tests ---\n");
+
+    test_push_and_index();
+    test_stable_addresses();
+
+    printf("--- Integer Segmented Array Tests Passed ---\n");
+
+    return 0;
+}
@@ -0,0 +1,6 @@
+#include "particle_soa_array.h"
+
+#include "soa_array_macros.h"
+
+DEFINE_SOA_ARRAY_STRUCT(particle, Particle, PARTICLE_FIELDS)
+DEFINE_SOA_ARRAY_FUNCTIONS(particle, Particle, PARTICLE_FIELDS)
@@ -0,0 +1,18 @@
+#ifndef ARRAY_MACROS_PARTICLE_SOA_ARRAY_H
+#define ARRAY_MACROS_PARTICLE_SOA_ARRAY_H
+
+#include <stdint.h>
+
+#include "soa_array_macros.h"
+
+#define PARTICLE_FIELDS(X) \
+    X(float, x)            \
+    X(float, y)            \
+    X(double, mass)        \
+    X(uint8_t, flags)      \
+    X(int, id)
+
+DECLARE_SOA_ARRAY_STRUCT(particle, Particle, PARTICLE_FIELDS)
+DECLARE_SOA_ARRAY_FUNCTIONS(particle, Particle, PARTICLE_FIELDS)
+
+#endif // ARRAY_MACROS_PARTICLE_SOA_ARRAY_H
@@ -0,0 +1,149 @@
+/* Keep assert active in release builds. */
+#undef NDEBUG
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "particle_soa_array.h"
+
+static Particle make_particle(int id) {
+    return (Particle){
+        .x = (float)id,
+        .y = (float)-id,
+        .mass = id * 0.5,
+        .flags = (uint8_t)(id & 0xff),
+        .id = id,
+    };
+}
+
+static void assert_particle(ParticleSoaArray* q, size_t index, int id) {
+    Particle item;
+    assert(particle_soa_array_get(q, index, &item));
+    assert(item.x == (float)id);
+    assert(item.y == (float)-id);
+    assert(item.mass == id * 0.5);
+    assert(item.flags == (uint8_t)(id & 0xff));
+    assert(item.id == id);
+}
+
+static void test_push_and_grow(void) {
+    ParticleSoaArray* q = particle_soa_array_create(1);
+    assert(q != NULL);
+    assert(particle_soa_array_is_empty(q));
+
+    for (int i = 0; i < 1000; i++) {
+        assert(particle_soa_array_push(q, make_particle(i)));
+    }
+    assert(particle_soa_array_get_count(q) == 1000);
+    assert(particle_soa_array_get_capacity(q) == 1024);
+
+    for (size_t i = 0; i < 1000; i++) {
+        assert_particle(q, i, (int)i);
+    }
+
+    particle_soa_array_free(q);
+}
+
+static void test_columns(void) {
+    ParticleSoaArray* q = particle_soa_array_create(8);
+    assert(q != NULL);
+
+    for (int i = 0; i < 100; i++) {
+        assert(particle_soa_array_push(q, make_particle(i)));
+    }
+
+    /* Every column starts on its own aligned boundary. */
+    ParticleConstColumns columns = particle_soa_array_get_columns(q);
+    assert((uintptr_t)columns.x % SOA_ARRAY_COLUMN_ALIGNMENT == 0);
+    assert((uintptr_t)columns.y % SOA_ARRAY_COLUMN_ALIGNMENT == 0);
+    assert((uintptr_t)columns.mass % SOA_ARRAY_COLUMN_ALIGNMENT == 0);
+    assert((uintptr_t)columns.flags % SOA_ARRAY_COLUMN_ALIGNMENT == 0);
+    assert((uintptr_t)columns.id % SOA_ARRAY_COLUMN_ALIGNMENT == 0);
+
+    double total_mass = 0;
+    for (size_t i = 0; i < particle_soa_array_get_count(q); i++) {
+        total_mass += columns.mass[i];
+    }
+    assert(total_mass == 4950 * 0.5);
+
+    ParticleColumns writable = particle_soa_array_get_columns_mut(q);
+    assert((const float*)writable.x == columns.x);
+    for (size_t i = 0; i < particle_soa_array_get_count(q); i++) {
+        writable.x[i] *= 2;
+    }
+
+    Particle item;
+    assert(particle_soa_array_get(q, 10, &item));
+    assert(item.x == 20.0f);
+    assert(item.y == -10.0f);
+
+    particle_soa_array_free(q);
+}
+
+static void test_insert_remove_set(void) {
+    ParticleSoaArray* q = particle_soa_array_create(4);
+    assert(q != NULL);
+
+    for (int i = 0; i < 4; i++) {
+        assert(particle_soa_array_push(q, make_particle(i)));
+    }
+
+    assert(particle_soa_array_insert(q, 2, make_particle(42)));
+    assert(particle_soa_array_insert(q, 5, make_particle(43)));
+    assert(!particle_soa_array_insert(q, 7, make_particle(44)));
+    assert(particle_soa_array_get_last_error(q) == ARRAY_ERROR_TYPE_OUT_OF_BOUNDS);
+
+    const int expected[] = {0, 1, 42, 2, 3, 43};
+    assert(particle_soa_array_get_count(q) == 6);
+    for (size_t i = 0; i < 6; i++) {
+        assert_particle(q, i, expected[i]);
+    }
+
+    assert(particle_soa_array_remove(q, 0));
+    assert(particle_soa_array_remove(q, 4));
+    assert(particle_soa_array_set(q, 0, make_particle(7)));
+    assert(!particle_soa_array_set(q, 4, make_particle(8)));
+
+    const int remaining[] = {7, 42, 2, 3};
+    assert(particle_soa_array_get_count(q) == 4);
+    for (size_t i = 0; i < 4; i++) {
+        assert_particle(q, i, remaining[i]);
+    }
+
+    assert(particle_soa_array_reserve(q, 100));
+    assert(particle_soa_array_get_capacity(q) == 100);
+    assert_particle(q, 3, 3);
+
+    particle_soa_array_clear(q);
+    assert(!particle_soa_array_remove(q, 0));
+    assert(particle_soa_array_get_last_error(q) == ARRAY_ERROR_TYPE_EMPTY);
+
+    particle_soa_array_free(q);
+}
+
+static void test_capacity_overflow(void) {
+    ParticleSoaArray* q = particle_soa_array_create(4);
+    assert(q != NULL);
+
+    /* Too large for the column sizes to add up, so nothing is allocated. */
+    assert(!particle_soa_array_reserve(q, SIZE_MAX / 2));
+    assert(particle_soa_array_get_last_error(q) == ARRAY_ERROR_TYPE_OVERFLOW);
+    assert(particle_soa_array_get_capacity(q) == 4);
+
+    assert(particle_soa_array_create(SIZE_MAX / 2) == NULL);
+
+    particle_soa_array_free(q);
+}
+
+int main(void) {
+    printf("--- Running Particle SoA Array Tests ---\n");
+
+    test_push_and_grow();
+    test_columns();
+    test_insert_remove_set();
+    test_capacity_overflow();
+
+    printf("--- Particle SoA Array Tests Passed ---\n");
+
+    return 0;
+}